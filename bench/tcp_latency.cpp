@@ -1,3 +1,4 @@
+#include <vix/net_corosio/config.hpp>
 #include <vix/net_corosio/context.hpp>
 #include <vix/net_corosio/error.hpp>
 #include <vix/net_corosio/listener.hpp>
@@ -16,19 +17,20 @@ using namespace vix::net_corosio;
 
 namespace vix::net_corosio::bench
 {
-  static void server_pingpong(std::uint16_t port, std::atomic<bool> &ready, std::atomic<bool> &stop_flag)
+  static void server_pingpong(const Config &cfg, std::atomic<std::uint16_t> &port,
+                              std::atomic<bool> &stop_flag)
   {
-    Context ctx;
+    Context ctx(cfg);
 
     Listener listener(ctx);
     if (listener.open())
       return;
-    if (listener.bind(port))
+    if (listener.bind(0))
       return;
     if (listener.listen(1))
       return;
 
-    ready.store(true, std::memory_order_release);
+    port.store(listener.local_endpoint().port, std::memory_order_release);
 
     auto accepted = listener.accept();
     if (!accepted.ok())
@@ -53,35 +55,45 @@ namespace vix::net_corosio::bench
     listener.close();
   }
 
-  static int run_tcp_latency()
+  struct LatencyStats final
+  {
+    std::size_t samples{0};
+    double min_us{0.0};
+    double p50_us{0.0};
+    double p90_us{0.0};
+    double p99_us{0.0};
+    double max_us{0.0};
+  };
+
+  // Ping-pong 1-byte messages; returns false when no sample was taken.
+  static bool measure(const Config &cfg, LatencyStats &out)
   {
-    constexpr std::uint16_t port = 19082;
     constexpr int iters = 2000;
 
-    std::atomic<bool> ready{false};
+    std::atomic<std::uint16_t> port{0};
     std::atomic<bool> stop_flag{false};
 
     std::thread server([&]
-                       { server_pingpong(port, ready, stop_flag); });
+                       { server_pingpong(cfg, port, stop_flag); });
 
-    while (!ready.load(std::memory_order_acquire))
+    while (port.load(std::memory_order_acquire) == 0)
     {
       std::this_thread::sleep_for(std::chrono::milliseconds(5));
     }
 
-    Context ctx;
+    Context ctx(cfg);
     Socket sock(ctx);
 
     TcpEndpoint ep{};
     ep.address = "127.0.0.1";
-    ep.port = port;
+    ep.port = port.load(std::memory_order_acquire);
 
     if (sock.connect(ep))
     {
       stop_flag.store(true, std::memory_order_release);
       server.join();
       std::cerr << "[tcp_latency] connect failed\n";
-      return 1;
+      return false;
     }
 
     std::vector<double> rtts_us;
@@ -114,33 +126,64 @@ namespace vix::net_corosio::bench
     if (rtts_us.empty())
     {
       std::cerr << "[tcp_latency] no samples\n";
-      return 1;
+      return false;
     }
 
     std::sort(rtts_us.begin(), rtts_us.end());
 
     auto pct = [&](double p) -> double
     {
-      if (rtts_us.empty())
-        return 0.0;
       const double idx = (p / 100.0) * (static_cast<double>(rtts_us.size() - 1));
       const std::size_t i = static_cast<std::size_t>(idx);
       return rtts_us[i];
     };
 
-    const double p50 = pct(50.0);
-    const double p90 = pct(90.0);
-    const double p99 = pct(99.0);
-    const double minv = rtts_us.front();
-    const double maxv = rtts_us.back();
-
-    std::cout << "[tcp_latency]\n";
-    std::cout << "  samples: " << rtts_us.size() << "\n";
-    std::cout << "  min(us): " << minv << "\n";
-    std::cout << "  p50(us): " << p50 << "\n";
-    std::cout << "  p90(us): " << p90 << "\n";
-    std::cout << "  p99(us): " << p99 << "\n";
-    std::cout << "  max(us): " << maxv << "\n";
+    out.samples = rtts_us.size();
+    out.min_us = rtts_us.front();
+    out.p50_us = pct(50.0);
+    out.p90_us = pct(90.0);
+    out.p99_us = pct(99.0);
+    out.max_us = rtts_us.back();
+    return true;
+  }
+
+  static void print(const char *label, const LatencyStats &st)
+  {
+    std::cout << "[tcp_latency] " << label << "\n";
+    std::cout << "  samples: " << st.samples << "\n";
+    std::cout << "  min(us): " << st.min_us << "\n";
+    std::cout << "  p50(us): " << st.p50_us << "\n";
+    std::cout << "  p90(us): " << st.p90_us << "\n";
+    std::cout << "  p99(us): " << st.p99_us << "\n";
+    std::cout << "  max(us): " << st.max_us << "\n";
+  }
+
+  static int run_tcp_latency()
+  {
+    // Same workload with and without Config::speculative_io. Both runs
+    // disable Nagle and delayed ACKs so 1-byte messages leave immediately.
+    Config reactor = default_config();
+    reactor.speculative_io = false;
+    reactor.socket_options.no_delay = true;
+    reactor.socket_options.quick_ack = true;
+
+    Config speculative = reactor;
+    speculative.speculative_io = true;
+
+    LatencyStats base{};
+    LatencyStats fast{};
+
+    if (!measure(reactor, base))
+      return 1;
+
+    if (!measure(speculative, fast))
+      return 1;
+
+    print("reactor only (speculative_io=false)", base);
+    print("speculative (speculative_io=true)", fast);
+
+    if (fast.p50_us > 0.0)
+      std::cout << "  p50 speedup: " << (base.p50_us / fast.p50_us) << "x\n";
 
     return 0;
   }
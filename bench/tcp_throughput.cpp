@@ -1,3 +1,4 @@
+#include <vix/net_corosio/buffer_pool.hpp>
 #include <vix/net_corosio/context.hpp>
 #include <vix/net_corosio/error.hpp>
 #include <vix/net_corosio/listener.hpp>
@@ -8,10 +9,14 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <thread>
-#include <vector>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
 
 using namespace vix::net_corosio;
 
@@ -21,21 +26,40 @@ namespace vix::net_corosio::bench
   {
     std::uint64_t bytes_total{0};
     std::uint64_t seconds{0};
+    double sender_cpu_seconds{0.0};
+    bool zero_copy{false};
   };
 
-  static void server_worker(std::uint16_t port, std::atomic<bool> &ready, std::atomic<bool> &stop_flag, ThroughputResult &out)
+  // CPU time consumed by the calling thread (user + system).
+  static double thread_cpu_seconds()
+  {
+#if defined(__linux__)
+    rusage ru{};
+    if (getrusage(RUSAGE_THREAD, &ru) != 0)
+      return 0.0;
+
+    const auto tv = [](const timeval &t)
+    { return static_cast<double>(t.tv_sec) + static_cast<double>(t.tv_usec) / 1e6; };
+
+    return tv(ru.ru_utime) + tv(ru.ru_stime);
+#else
+    return 0.0;
+#endif
+  }
+
+  static void server_worker(std::atomic<std::uint16_t> &port, std::atomic<bool> &stop_flag, ThroughputResult &out)
   {
     Context ctx;
 
     Listener listener(ctx);
     if (listener.open())
       return;
-    if (listener.bind(port))
+    if (listener.bind(0))
       return;
     if (listener.listen(1))
       return;
 
-    ready.store(true, std::memory_order_release);
+    port.store(listener.local_endpoint().port, std::memory_order_release);
 
     auto accepted = listener.accept();
     if (!accepted.ok())
@@ -43,7 +67,9 @@ namespace vix::net_corosio::bench
 
     Socket &client = accepted.socket;
 
-    std::vector<std::uint8_t> buffer(64 * 1024);
+    PooledBuffer buffer = ctx.buffer_pool().acquire(64 * 1024);
+    if (!buffer)
+      return;
 
     const auto start = std::chrono::steady_clock::now();
 
@@ -68,7 +94,7 @@ namespace vix::net_corosio::bench
     listener.close();
   }
 
-  static void client_worker(std::string host, std::uint16_t port, std::chrono::seconds duration)
+  static void client_worker(std::string host, std::uint16_t port, std::chrono::seconds duration, bool zero_copy, ThroughputResult &out)
   {
     Context ctx;
     Socket sock(ctx);
@@ -77,45 +103,55 @@ namespace vix::net_corosio::bench
     ep.address = std::move(host);
     ep.port = port;
 
+    if (sock.open())
+      return;
+
+    if (zero_copy)
+      out.zero_copy = !sock.set_zero_copy(true);
+
     if (sock.connect(ep))
       return;
 
-    std::vector<std::uint8_t> buffer(64 * 1024, 0xAB);
+    PooledBuffer buffer = ctx.buffer_pool().acquire(64 * 1024);
+    if (!buffer)
+      return;
+    std::memset(buffer.data(), 0xAB, buffer.size());
 
+    const double cpu_start = thread_cpu_seconds();
     const auto start = std::chrono::steady_clock::now();
 
     while (std::chrono::steady_clock::now() - start < duration)
     {
-      auto w = sock.write_some(buffer.data(), buffer.size());
+      auto w = sock.write_all(buffer.data(), buffer.size());
       if (!w.ok())
         break;
-      if (w.bytes == 0)
-        break;
     }
 
+    out.sender_cpu_seconds = thread_cpu_seconds() - cpu_start;
+
     sock.close();
   }
 
-  static int run_tcp_throughput()
+  static ThroughputResult measure(bool zero_copy)
   {
-    constexpr std::uint16_t port = 19081;
     constexpr auto duration = std::chrono::seconds(3);
 
-    std::atomic<bool> ready{false};
+    std::atomic<std::uint16_t> port{0};
     std::atomic<bool> stop_flag{false};
 
     ThroughputResult result{};
+    ThroughputResult sender{};
 
     std::thread server([&]
-                       { server_worker(port, ready, stop_flag, result); });
+                       { server_worker(port, stop_flag, result); });
 
-    while (!ready.load(std::memory_order_acquire))
+    while (port.load(std::memory_order_acquire) == 0)
     {
       std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 
     std::thread client([&]
-                       { client_worker("127.0.0.1", port, duration); });
+                       { client_worker("127.0.0.1", port.load(std::memory_order_acquire), duration, zero_copy, sender); });
 
     std::this_thread::sleep_for(duration);
     stop_flag.store(true, std::memory_order_release);
@@ -123,14 +159,44 @@ namespace vix::net_corosio::bench
     client.join();
     server.join();
 
-    const double sec = (result.seconds == 0) ? duration.count() : static_cast<double>(result.seconds);
-    const double mb = static_cast<double>(result.bytes_total) / (1024.0 * 1024.0);
-    const double mbps = mb / sec;
+    if (result.seconds == 0)
+      result.seconds = static_cast<std::uint64_t>(duration.count());
 
-    std::cout << "[tcp_throughput]\n";
-    std::cout << "  bytes: " << result.bytes_total << "\n";
+    result.sender_cpu_seconds = sender.sender_cpu_seconds;
+    result.zero_copy = sender.zero_copy;
+    return result;
+  }
+
+  static void print(const char *label, const ThroughputResult &r)
+  {
+    const double sec = static_cast<double>(r.seconds);
+    const double mb = static_cast<double>(r.bytes_total) / (1024.0 * 1024.0);
+    const double gib = mb / 1024.0;
+
+    std::cout << "[tcp_throughput] " << label << "\n";
+    std::cout << "  bytes: " << r.bytes_total << "\n";
     std::cout << "  seconds: " << sec << "\n";
-    std::cout << "  throughput: " << mbps << " MiB/s\n";
+    std::cout << "  throughput: " << mb / sec << " MiB/s\n";
+
+    if (gib > 0.0 && r.sender_cpu_seconds > 0.0)
+      std::cout << "  sender cpu: " << r.sender_cpu_seconds * 1000.0 / gib << " ms/GiB\n";
+  }
+
+  static int run_tcp_throughput()
+  {
+    const ThroughputResult copy = measure(false);
+    print("copy", copy);
+
+    const ThroughputResult zc = measure(true);
+    if (!zc.zero_copy)
+    {
+      std::cout << "[tcp_throughput] zero copy: not supported on this platform\n";
+      return 0;
+    }
+
+    // Loopback never transmits from user pages: the kernel copies anyway
+    // and the notification overhead shows. Measure against a remote peer.
+    print("zero copy (MSG_ZEROCOPY)", zc);
 
     return 0;
   }
@@ -42,7 +42,7 @@ namespace vix::net_corosio::example
       line.push_back('\n');
 
       {
-        const auto w = sock.write_some(line.data(), line.size());
+        const auto w = sock.write_all(line.data(), line.size());
         if (!w.ok())
         {
           std::cerr << "[echo_client] write failed: " << static_cast<int>(w.error.code) << "\n";
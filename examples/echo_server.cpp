@@ -1,13 +1,14 @@
+#include <vix/net_corosio/buffer_pool.hpp>
 #include <vix/net_corosio/context.hpp>
 #include <vix/net_corosio/error.hpp>
 #include <vix/net_corosio/listener.hpp>
 #include <vix/net_corosio/socket.hpp>
+#include <vix/net_corosio/task.hpp>
 
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <string>
-#include <vector>
 
 namespace vix::net_corosio::example
 {
@@ -48,42 +49,51 @@ namespace vix::net_corosio::example
 
     std::cout << "[echo_server] listening on 0.0.0.0:" << port << "\n";
 
-    std::vector<std::uint8_t> buffer(16 * 1024);
-
-    for (;;)
+    // One coroutine per client; all of them share this thread and Context.
+    // An idle client holds no buffer: it waits for readability first and
+    // borrows one from the context's pool only while echoing a burst.
+    auto echo = [&ctx](Socket client) -> Task<>
     {
-      auto accepted = listener.accept();
-      if (!accepted.ok())
-      {
-        std::cerr << "[echo_server] accept failed: " << static_cast<int>(accepted.error.code) << "\n";
-        continue;
-      }
-
-      Socket &client = accepted.socket;
-
       for (;;)
       {
-        auto r = client.read_some(buffer.data(), buffer.size());
-        if (!r.ok())
-        {
-          // Client closed or IO error.
-          client.close();
+        // not_supported: no readiness wait here, read with a buffer at once.
+        const Error ready = co_await client.async_wait_readable();
+        if (ready && ready.code != ErrorCode::not_supported)
+          break;
+
+        PooledBuffer buffer = ctx.buffer_pool().acquire(16 * 1024);
+        if (!buffer)
           break;
-        }
 
-        if (r.bytes == 0)
+        auto r = co_await client.async_read_some(buffer.data(), buffer.size());
+        if (!r.ok() || r.bytes == 0)
         {
-          client.close();
+          // Client closed or IO error.
           break;
         }
 
-        auto w = client.write_some(buffer.data(), r.bytes);
+        auto w = co_await client.async_write_all(buffer.data(), r.bytes);
         if (!w.ok())
-        {
-          client.close();
           break;
-        }
       }
+
+      client.close();
+    };
+
+    auto accept_loop = [&]() -> Task<>
+    {
+      const Error e = co_await listener.serve(echo);
+      if (e)
+        std::cerr << "[echo_server] accept failed: " << static_cast<int>(e.code) << "\n";
+    };
+
+    ctx.spawn(accept_loop());
+
+    const Error e = ctx.run();
+    if (e)
+    {
+      std::cerr << "[echo_server] run failed: " << static_cast<int>(e.code) << "\n";
+      return 1;
     }
 
     return 0;
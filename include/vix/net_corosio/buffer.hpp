@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace vix::net_corosio
+{
+  /**
+   * @brief Read-only view of caller-owned bytes.
+   *
+   * Used by scatter/gather writes: several ConstBuffers are sent with one
+   * writev() instead of being copied into a staging buffer first.
+   */
+  struct ConstBuffer final
+  {
+    const void *data{nullptr};
+    std::size_t size{0};
+  };
+
+  /**
+   * @brief Writable view of caller-owned bytes, filled by scatter reads.
+   */
+  struct MutableBuffer final
+  {
+    void *data{nullptr};
+    std::size_t size{0};
+
+    constexpr operator ConstBuffer() const noexcept
+    {
+      return ConstBuffer{data, size};
+    }
+  };
+
+  /**
+   * @brief Total number of bytes in a buffer sequence.
+   */
+  constexpr std::size_t buffer_size(std::span<const ConstBuffer> buffers) noexcept
+  {
+    std::size_t n = 0;
+    for (const auto &b : buffers)
+      n += b.size;
+    return n;
+  }
+
+  constexpr std::size_t buffer_size(std::span<const MutableBuffer> buffers) noexcept
+  {
+    std::size_t n = 0;
+    for (const auto &b : buffers)
+      n += b.size;
+    return n;
+  }
+
+} // namespace vix::net_corosio
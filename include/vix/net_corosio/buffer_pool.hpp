@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+#include <vix/net_corosio/buffer.hpp>
+
+namespace vix::net_corosio
+{
+  /**
+   * @brief Tuning for BufferPool. See Config::buffer_pool.
+   */
+  struct BufferPoolOptions final
+  {
+    /**
+     * @brief Bytes reserved up front for buffers, carved into blocks on demand.
+     *
+     * 0 (default) takes every block from the heap. An arena keeps buffers
+     * in one mapping, so idle ones can be handed back to the kernel by
+     * trim() without fragmenting the heap.
+     */
+    std::size_t arena_bytes{0};
+
+    /**
+     * @brief Back the arena with huge pages (MAP_HUGETLB).
+     *
+     * Falls back to a regular mapping with transparent huge pages advised
+     * when no huge pages are reserved; see BufferPool::huge_pages().
+     */
+    bool huge_pages{false};
+
+    /**
+     * @brief Free blocks each thread keeps per size class before handing
+     * them to the shared list.
+     */
+    std::size_t thread_cache_blocks{8};
+  };
+
+  /**
+   * @brief Counters for BufferPool, in bytes of block capacity.
+   */
+  struct BufferPoolStats final
+  {
+    std::size_t in_use_bytes{0};
+    std::size_t idle_bytes{0};
+    std::size_t arena_bytes{0};
+    std::size_t arena_used_bytes{0};
+  };
+
+  class PooledBuffer;
+
+  /**
+   * @brief Shared pool of I/O buffers, owned by a Context.
+   *
+   * Blocks come in fixed power-of-two size classes from 4 KiB to 64 KiB,
+   * page aligned. Each thread keeps a few free blocks per class, so a
+   * release followed by an acquire on the same thread takes no lock;
+   * the rest go to a shared free list. Larger requests are served by a
+   * dedicated allocation that is freed on release.
+   *
+   * Connections that hold a buffer only while moving data let many mostly
+   * idle connections share a small set of blocks instead of each pinning
+   * its own.
+   *
+   * Thread-safe. Buffers may be released on any thread.
+   */
+  class BufferPool final
+  {
+  public:
+    static constexpr std::size_t min_block = 4 * 1024;
+    static constexpr std::size_t max_block = 64 * 1024;
+    static constexpr std::size_t classes = 5; // 4, 8, 16, 32, 64 KiB
+
+    explicit BufferPool(BufferPoolOptions options = {});
+
+    BufferPool(BufferPool &&) noexcept;
+    BufferPool &operator=(BufferPool &&) noexcept;
+
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    ~BufferPool();
+
+    /**
+     * @brief Take a buffer of at least bytes bytes (0 means min_block).
+     *
+     * Returns an empty handle when memory is exhausted.
+     */
+    PooledBuffer acquire(std::size_t bytes);
+
+    /**
+     * @brief Release idle blocks held by the shared free list.
+     *
+     * Heap blocks are freed. Arena blocks stay reserved but all pages
+     * after their first go back to the kernel (not with huge pages).
+     * Per-thread caches are untouched. Returns the bytes released.
+     */
+    std::size_t trim() noexcept;
+
+    /**
+     * @brief True when the arena is backed by MAP_HUGETLB pages.
+     */
+    bool huge_pages() const noexcept;
+
+    BufferPoolStats stats() const noexcept;
+
+  private:
+    friend class PooledBuffer;
+
+    struct Impl;
+    std::shared_ptr<Impl> impl_;
+  };
+
+  /**
+   * @brief Owning handle to one pooled I/O buffer.
+   *
+   * Move-only; the block goes back to its pool on destruction or reset().
+   * Pass data()/size() to read_some/write_some, or buffer() to the
+   * scatter/gather forms. Contents are not initialised.
+   *
+   * A handle must not outlive the Context whose pool it came from.
+   */
+  class PooledBuffer final
+  {
+  public:
+    PooledBuffer() noexcept = default;
+
+    PooledBuffer(PooledBuffer &&other) noexcept;
+    PooledBuffer &operator=(PooledBuffer &&other) noexcept;
+
+    PooledBuffer(const PooledBuffer &) = delete;
+    PooledBuffer &operator=(const PooledBuffer &) = delete;
+
+    ~PooledBuffer();
+
+    explicit operator bool() const noexcept { return data_ != nullptr; }
+
+    char *data() noexcept { return data_; }
+    const char *data() const noexcept { return data_; }
+
+    /**
+     * @brief Bytes requested from acquire().
+     */
+    std::size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Usable bytes: size() rounded up to the block's size class.
+     */
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    MutableBuffer buffer() noexcept { return MutableBuffer{data_, size_}; }
+    ConstBuffer buffer() const noexcept { return ConstBuffer{data_, size_}; }
+
+    std::span<char> span() noexcept { return {data_, size_}; }
+
+    /**
+     * @brief Return the block to its pool now.
+     */
+    void reset() noexcept;
+
+  private:
+    friend class BufferPool;
+
+    PooledBuffer(BufferPool::Impl *owner, char *data, std::size_t size, std::size_t capacity) noexcept
+        : owner_(owner), data_(data), size_(size), capacity_(capacity)
+    {
+    }
+
+    BufferPool::Impl *owner_{nullptr};
+    char *data_{nullptr};
+    std::size_t size_{0};
+    std::size_t capacity_{0};
+  };
+
+} // namespace vix::net_corosio
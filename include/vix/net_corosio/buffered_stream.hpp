@@ -0,0 +1,407 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <vix/net_corosio/buffer.hpp>
+#include <vix/net_corosio/deadline.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/ring_buffer.hpp>
+#include <vix/net_corosio/task.hpp>
+
+namespace vix::net_corosio
+{
+  /**
+   * @brief Buffer sizes for BufferedStream.
+   */
+  struct BufferedStreamOptions final
+  {
+    std::size_t read_buffer_bytes{16 * 1024};
+    std::size_t write_buffer_bytes{16 * 1024};
+
+    // Mirrored read buffer, see RingBuffer.
+    bool mirror{false};
+  };
+
+  /**
+   * @brief Read-ahead and write-behind buffering over a Socket or TlsStream.
+   *
+   * Reads fill the whole free read buffer with one read_some() and serve
+   * small reads, peek() and consume() from memory, so a parser taking a
+   * few bytes at a time costs one syscall per buffer instead of one per
+   * call. Reads at least as large as the buffer bypass it.
+   *
+   * write() only copies into the write buffer; bytes reach the stream when
+   * the buffer would overflow (pending bytes and the new data then leave
+   * together in one gather write) or on flush(). Call flush() before
+   * waiting for a reply.
+   *
+   * hold() (used by the framing helpers, see framing.hpp) hands out
+   * buffered bytes as a view without copying; held bytes are consumed
+   * by the next read, fill, ensure or consume, and their views stay valid
+   * until then.
+   *
+   * The stream must outlive the BufferedStream. Deadlines apply to each
+   * underlying read or write, as for the stream itself.
+   */
+  template <class Stream>
+  class BufferedStream final
+  {
+  public:
+    using result_type = decltype(std::declval<Stream &>().read_some(
+        static_cast<void *>(nullptr), std::size_t{}, Deadline{}));
+
+    explicit BufferedStream(Stream &next, BufferedStreamOptions options = {})
+        : next_(&next),
+          in_(options.read_buffer_bytes, options.mirror),
+          out_capacity_(std::max<std::size_t>(options.write_buffer_bytes, 1))
+    {
+      out_.reserve(out_capacity_);
+    }
+
+    BufferedStream(BufferedStream &&) noexcept = default;
+    BufferedStream &operator=(BufferedStream &&) noexcept = default;
+
+    BufferedStream(const BufferedStream &) = delete;
+    BufferedStream &operator=(const BufferedStream &) = delete;
+
+    Stream &next_layer() noexcept { return *next_; }
+
+    /**
+     * @brief Bytes received and not yet consumed or held.
+     */
+    std::string_view peek() const noexcept { return in_.view().substr(held_); }
+
+    std::size_t buffered() const noexcept { return in_.size() - held_; }
+
+    /**
+     * @brief Drop n bytes from the front of peek().
+     */
+    void consume(std::size_t n) noexcept
+    {
+      settle();
+      in_.consume(n);
+    }
+
+    /**
+     * @brief Take the first n bytes of peek() as a view, without copying.
+     *
+     * The bytes leave peek() now and the buffer at the next read, fill,
+     * ensure or consume; the view is valid until then.
+     */
+    std::string_view hold(std::size_t n) noexcept
+    {
+      const std::string_view out = peek().substr(0, n);
+      held_ += out.size();
+      return out;
+    }
+
+    /**
+     * @brief The read buffer, for helpers that parse in place.
+     */
+    RingBuffer &read_buffer() noexcept { return in_; }
+
+    /**
+     * @brief Bytes written and not yet flushed.
+     */
+    std::size_t pending() const noexcept { return out_.size(); }
+
+    /**
+     * @brief One read_some() into the free part of the read buffer.
+     *
+     * bytes is what was added; 0 means end of stream. A full buffer
+     * reports invalid_state: consume() first.
+     */
+    result_type fill(Deadline deadline = {})
+    {
+      settle();
+
+      if (in_.full())
+        return result_type{Error{ErrorCode::invalid_state}, 0};
+
+      const MutableBuffer room = in_.prepare();
+      auto r = next_->read_some(room.data, room.size, deadline);
+      if (r.ok())
+        in_.commit(r.bytes);
+      return r;
+    }
+
+    /**
+     * @brief Read until at least n bytes are buffered.
+     *
+     * n larger than the read buffer reports invalid_argument; end of
+     * stream first reports connection_closed. bytes is buffered().
+     */
+    result_type ensure(std::size_t n, Deadline deadline = {})
+    {
+      settle();
+
+      if (n > in_.capacity())
+        return result_type{Error{ErrorCode::invalid_argument}, in_.size()};
+
+      while (in_.size() < n)
+      {
+        auto r = fill(deadline);
+        if (!r.ok())
+          return result_type{r.error, in_.size()};
+        if (r.bytes == 0)
+          return result_type{Error{ErrorCode::connection_closed}, in_.size()};
+      }
+
+      return result_type{Error{ErrorCode::none}, in_.size()};
+    }
+
+    /**
+     * @brief Read some bytes: buffered ones first, else one fill().
+     *
+     * 0 bytes means end of stream.
+     */
+    result_type read_some(void *data, std::size_t size, Deadline deadline = {})
+    {
+      settle();
+
+      if (size == 0 || !in_.empty())
+        return result_type{Error{ErrorCode::none}, take(data, size)};
+
+      if (size >= in_.capacity())
+        return next_->read_some(data, size, deadline);
+
+      auto r = fill(deadline);
+      if (!r.ok() || r.bytes == 0)
+        return r;
+
+      return result_type{Error{ErrorCode::none}, take(data, size)};
+    }
+
+    /**
+     * @brief Read exactly size bytes; connection_closed on early EOF.
+     */
+    result_type read_exact(void *data, std::size_t size, Deadline deadline = {})
+    {
+      settle();
+
+      auto *p = static_cast<char *>(data);
+      std::size_t done = take(p, size);
+
+      if (done < size && size - done >= in_.capacity())
+      {
+        auto r = next_->read_exact(p + done, size - done, deadline);
+        return result_type{r.error, done + r.bytes};
+      }
+
+      while (done < size)
+      {
+        auto r = fill(deadline);
+        if (!r.ok())
+          return result_type{r.error, done};
+        if (r.bytes == 0)
+          return result_type{Error{ErrorCode::connection_closed}, done};
+
+        done += take(p + done, size - done);
+      }
+
+      return result_type{Error{ErrorCode::none}, done};
+    }
+
+    /**
+     * @brief Queue size bytes for sending.
+     *
+     * Copies when they fit in the write buffer. Otherwise sends pending
+     * bytes and data together with one gather write_all(). bytes counts
+     * data accepted, buffered or sent.
+     */
+    result_type write(const void *data, std::size_t size, Deadline deadline = {})
+    {
+      if (append(data, size))
+        return result_type{Error{ErrorCode::none}, size};
+
+      const ConstBuffer both[2] = {{out_.data(), out_.size()}, {data, size}};
+      auto r = next_->write_all(std::span<const ConstBuffer>(both, 2), deadline);
+      return result_type{r.error, sent(r.bytes)};
+    }
+
+    /**
+     * @brief Send every pending byte.
+     */
+    result_type flush(Deadline deadline = {})
+    {
+      if (out_.empty())
+        return result_type{Error{ErrorCode::none}, 0};
+
+      auto r = next_->write_all(out_.data(), out_.size(), deadline);
+      drop_sent(r.bytes);
+      return r;
+    }
+
+    /**
+     * @brief Awaitable form of fill().
+     */
+    Task<result_type> async_fill(Deadline deadline = {})
+    {
+      settle();
+
+      if (in_.full())
+        co_return result_type{Error{ErrorCode::invalid_state}, 0};
+
+      const MutableBuffer room = in_.prepare();
+      auto r = co_await next_->async_read_some(room.data, room.size, deadline);
+      if (r.ok())
+        in_.commit(r.bytes);
+      co_return r;
+    }
+
+    /**
+     * @brief Awaitable form of ensure().
+     */
+    Task<result_type> async_ensure(std::size_t n, Deadline deadline = {})
+    {
+      settle();
+
+      if (n > in_.capacity())
+        co_return result_type{Error{ErrorCode::invalid_argument}, in_.size()};
+
+      while (in_.size() < n)
+      {
+        auto r = co_await async_fill(deadline);
+        if (!r.ok())
+          co_return result_type{r.error, in_.size()};
+        if (r.bytes == 0)
+          co_return result_type{Error{ErrorCode::connection_closed}, in_.size()};
+      }
+
+      co_return result_type{Error{ErrorCode::none}, in_.size()};
+    }
+
+    /**
+     * @brief Awaitable form of read_some().
+     */
+    Task<result_type> async_read_some(void *data, std::size_t size, Deadline deadline = {})
+    {
+      settle();
+
+      if (size == 0 || !in_.empty())
+        co_return result_type{Error{ErrorCode::none}, take(data, size)};
+
+      if (size >= in_.capacity())
+        co_return co_await next_->async_read_some(data, size, deadline);
+
+      auto r = co_await async_fill(deadline);
+      if (!r.ok() || r.bytes == 0)
+        co_return r;
+
+      co_return result_type{Error{ErrorCode::none}, take(data, size)};
+    }
+
+    /**
+     * @brief Awaitable form of read_exact().
+     */
+    Task<result_type> async_read_exact(void *data, std::size_t size, Deadline deadline = {})
+    {
+      settle();
+
+      auto *p = static_cast<char *>(data);
+      std::size_t done = take(p, size);
+
+      if (done < size && size - done >= in_.capacity())
+      {
+        auto r = co_await next_->async_read_exact(p + done, size - done, deadline);
+        co_return result_type{r.error, done + r.bytes};
+      }
+
+      while (done < size)
+      {
+        auto r = co_await async_fill(deadline);
+        if (!r.ok())
+          co_return result_type{r.error, done};
+        if (r.bytes == 0)
+          co_return result_type{Error{ErrorCode::connection_closed}, done};
+
+        done += take(p + done, size - done);
+      }
+
+      co_return result_type{Error{ErrorCode::none}, done};
+    }
+
+    /**
+     * @brief Awaitable form of write().
+     */
+    Task<result_type> async_write(const void *data, std::size_t size, Deadline deadline = {})
+    {
+      if (append(data, size))
+        co_return result_type{Error{ErrorCode::none}, size};
+
+      const ConstBuffer both[2] = {{out_.data(), out_.size()}, {data, size}};
+      auto r = co_await next_->async_write_all(std::span<const ConstBuffer>(both, 2), deadline);
+      co_return result_type{r.error, sent(r.bytes)};
+    }
+
+    /**
+     * @brief Awaitable form of flush().
+     */
+    Task<result_type> async_flush(Deadline deadline = {})
+    {
+      if (out_.empty())
+        co_return result_type{Error{ErrorCode::none}, 0};
+
+      auto r = co_await next_->async_write_all(out_.data(), out_.size(), deadline);
+      drop_sent(r.bytes);
+      co_return r;
+    }
+
+  private:
+    // Held bytes go once the caller moves on.
+    void settle() noexcept
+    {
+      in_.consume(held_);
+      held_ = 0;
+    }
+
+    // Copy up to size buffered bytes out.
+    std::size_t take(void *data, std::size_t size) noexcept
+    {
+      const std::size_t n = std::min(size, in_.size());
+      if (n != 0)
+      {
+        std::memcpy(data, in_.data().data, n);
+        in_.consume(n);
+      }
+      return n;
+    }
+
+    bool append(const void *data, std::size_t size)
+    {
+      if (size > out_capacity_ - out_.size())
+        return false;
+
+      const auto *p = static_cast<const char *>(data);
+      out_.insert(out_.end(), p, p + size);
+      return true;
+    }
+
+    // After a gather write of pending + data: bytes of data that went out.
+    std::size_t sent(std::size_t total) noexcept
+    {
+      const std::size_t pending = out_.size();
+      drop_sent(total);
+      return total > pending ? total - pending : 0;
+    }
+
+    void drop_sent(std::size_t n) noexcept
+    {
+      n = std::min(n, out_.size());
+      out_.erase(out_.begin(), out_.begin() + static_cast<std::ptrdiff_t>(n));
+    }
+
+    Stream *next_{nullptr};
+    RingBuffer in_;
+    std::size_t held_{0};
+    std::vector<char> out_;
+    std::size_t out_capacity_{0};
+  };
+
+} // namespace vix::net_corosio
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 
+#include <vix/net_corosio/buffer_pool.hpp>
+#include <vix/net_corosio/socket_options.hpp>
+
 namespace vix::net_corosio
 {
   /**
@@ -23,10 +27,79 @@ namespace vix::net_corosio
     /**
      * @brief Maximum number of worker tasks for server-style accept loops.
      *
-     * 0 means "backend default". Prefer explicit values for benchmarks.
+     * Used by Listener::serve() as the default cap on concurrently running
+     * connection handlers.
+     *
+     * 0 means "backend default" (unbounded). Prefer explicit values for benchmarks.
      */
     std::size_t max_workers{0};
 
+    /**
+     * @brief Number of threads Context::run() drives the event loop on.
+     *
+     * run() uses the calling thread plus io_threads - 1 internal threads.
+     * 0 and 1 both mean "calling thread only".
+     */
+    std::size_t io_threads{1};
+
+    /**
+     * @brief Default deadline for each Socket and TlsStream operation.
+     *
+     * Applied to connect, read, write and handshake when the caller passes
+     * no explicit Deadline. An operation that exceeds it is cancelled and
+     * reports ErrorCode::timeout. Sockets copy this value at construction;
+     * see Socket::set_timeout().
+     *
+     * 0 means no default deadline.
+     */
+    std::chrono::milliseconds io_timeout{0};
+
+    /**
+     * @brief Try a non-blocking recv()/send() before waiting on the reactor.
+     *
+     * When data (or send buffer space) is already available, Socket reads
+     * and writes complete on the calling thread without a coroutine frame or
+     * a loop iteration. Only would-block falls back to the reactor, which also
+     * reports EOF and errors, so results are the same either way.
+     */
+    bool speculative_io{true};
+
+    /**
+     * @brief Happy Eyeballs "Connection Attempt Delay" (RFC 8305).
+     *
+     * Socket::connect_any() starts the next address when the previous
+     * attempt has neither succeeded nor failed within this delay, so a
+     * blackholed address costs one delay instead of a full timeout. The
+     * RFC recommends 250 ms and no less than 10 ms.
+     */
+    std::chrono::milliseconds connect_attempt_delay{250};
+
+    /**
+     * @brief Options applied to every Socket when it is opened or accepted.
+     *
+     * Per-listener and per-socket options are layered on top, see
+     * Listener::set_options() and Socket::set_options(). Empty by default:
+     * kernel defaults apply.
+     */
+    SocketOptions socket_options{};
+
+    /**
+     * @brief Smallest write_all() payload sent with MSG_ZEROCOPY.
+     *
+     * Only used by sockets that enabled Socket::set_zero_copy(). Pinning
+     * pages and reaping the completion costs more than copying small
+     * buffers; the kernel documentation puts the break-even around 10 KiB.
+     */
+    std::size_t zero_copy_min_bytes{64 * 1024};
+
+    /**
+     * @brief Size and backing of Context::buffer_pool().
+     *
+     * Read when the Context is constructed; set_config() does not rebuild
+     * the pool.
+     */
+    BufferPoolOptions buffer_pool{};
+
     /**
      * @brief Enable strict defensive checks in the wrapper layer.
      *
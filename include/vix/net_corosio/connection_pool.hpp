@@ -0,0 +1,199 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include <vix/net_corosio/deadline.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/socket.hpp>
+#include <vix/net_corosio/task.hpp>
+#include <vix/net_corosio/tls_context.hpp>
+#include <vix/net_corosio/tls_stream.hpp>
+
+namespace vix::net_corosio
+{
+  class Context;
+
+  /**
+   * @brief Where a pooled connection goes.
+   *
+   * Connections are shared only between identical targets: same host and
+   * service, same TlsContext, and the same SNI hostname and ALPN list on
+   * that context at checkout time.
+   */
+  struct PoolTarget final
+  {
+    std::string host{};
+    std::string service{};
+
+    // Client TlsContext for TLS connections; nullptr for plain TCP.
+    TlsContext *tls{nullptr};
+  };
+
+  /**
+   * @brief ConnectionPool limits.
+   */
+  struct PoolOptions final
+  {
+    /**
+     * @brief Connections per target, idle and checked out together.
+     *
+     * A checkout beyond the limit parks until a release() or discard()
+     * for the same target wakes it, or until its deadline. 0 means
+     * unlimited.
+     */
+    std::size_t max_per_host{8};
+
+    /**
+     * @brief Idle connections older than this are closed, not reused.
+     *
+     * 0 keeps idle connections until the peer closes them.
+     */
+    std::chrono::milliseconds idle_timeout{std::chrono::seconds(30)};
+  };
+
+  /**
+   * @brief A connection checked out of a ConnectionPool.
+   *
+   * Move-only. release() hands the connection back for reuse once the
+   * caller has finished an exchange; destroying it without release()
+   * closes it, since the pool cannot know where the protocol stopped.
+   */
+  class PooledConnection final
+  {
+  public:
+    PooledConnection() noexcept = default;
+
+    PooledConnection(PooledConnection &&) noexcept;
+    PooledConnection &operator=(PooledConnection &&) noexcept;
+
+    PooledConnection(const PooledConnection &) = delete;
+    PooledConnection &operator=(const PooledConnection &) = delete;
+
+    ~PooledConnection();
+
+    /**
+     * @brief True while the connection is checked out.
+     */
+    explicit operator bool() const noexcept;
+
+    /**
+     * @brief The TCP socket. Requires a checked-out connection.
+     */
+    Socket &socket() noexcept;
+
+    /**
+     * @brief The TLS stream, or nullptr for plain TCP targets.
+     */
+    TlsStream *tls() noexcept;
+
+    /**
+     * @brief True if the connection came from the idle list, i.e. no
+     * connect and no handshake were needed.
+     */
+    bool reused() const noexcept;
+
+    /**
+     * @brief Return the connection to the pool for reuse.
+     *
+     * Closed sockets are dropped instead. The object is empty afterwards.
+     */
+    void release() noexcept;
+
+    /**
+     * @brief Close the connection and free its slot.
+     *
+     * TLS connections are closed without close_notify; call
+     * TlsStream::async_shutdown() first for a graceful close.
+     */
+    void discard() noexcept;
+
+  private:
+    friend class ConnectionPool;
+
+    struct Impl;
+    Impl *impl_{nullptr};
+  };
+
+  /**
+   * @brief Result of ConnectionPool::checkout().
+   */
+  struct CheckoutResult final
+  {
+    Error error{};
+    PooledConnection connection{};
+
+    bool ok() const noexcept { return error.ok(); }
+  };
+
+  /**
+   * @brief Outbound connection pool keyed by target and TLS identity.
+   *
+   * checkout() hands out the most recently released idle connection for
+   * the target after a liveness check (a connection the peer closed, or
+   * with unread bytes pending, TLS records included, is dropped).
+   * Otherwise it dials a new one with Socket::connect(host, service) and,
+   * for TLS targets, completes the handshake before returning.
+   *
+   * Safe to use from several loop threads of one Context. Connections may
+   * outlive the pool; released connections are then closed, and parked
+   * checkouts fail with invalid_state. The pool closes idle and evicted
+   * connections without a TLS shutdown, so it never blocks a loop thread.
+   */
+  class ConnectionPool final
+  {
+  public:
+    explicit ConnectionPool(Context &ctx, PoolOptions options = {});
+
+    ConnectionPool(ConnectionPool &&) noexcept;
+    ConnectionPool &operator=(ConnectionPool &&) noexcept;
+
+    ConnectionPool(const ConnectionPool &) = delete;
+    ConnectionPool &operator=(const ConnectionPool &) = delete;
+
+    ~ConnectionPool();
+
+    /**
+     * @brief Get a connection to target, reusing an idle one if possible.
+     *
+     * The deadline covers waiting for a slot, connecting and the TLS
+     * handshake; by default Config::io_timeout applies to the whole call.
+     */
+    CheckoutResult checkout(const PoolTarget &target, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of checkout().
+     */
+    Task<CheckoutResult> async_checkout(PoolTarget target, Deadline deadline = {});
+
+    /**
+     * @brief Close idle connections past PoolOptions::idle_timeout.
+     *
+     * checkout() and release() do this for their own target; call it
+     * periodically (e.g. from a Timer) to trim every target.
+     * Returns the number of connections closed.
+     */
+    std::size_t evict_idle();
+
+    /**
+     * @brief Close every idle connection. Checked-out ones are unaffected.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Idle connections, over all targets.
+     */
+    std::size_t idle_count() const noexcept;
+
+    /**
+     * @brief Checked-out connections and dials in progress, over all targets.
+     */
+    std::size_t in_use_count() const noexcept;
+
+  private:
+    struct Impl;
+    Impl *impl_{nullptr};
+  };
+
+} // namespace vix::net_corosio
@@ -3,13 +3,22 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <type_traits>
 
+#include <vix/net_corosio/buffer_pool.hpp>
 #include <vix/net_corosio/config.hpp>
 #include <vix/net_corosio/error.hpp>
 #include <vix/net_corosio/executor.hpp>
+#include <vix/net_corosio/task.hpp>
 
 namespace vix::net_corosio
 {
+  namespace detail
+  {
+    struct ContextAccess;
+  } // namespace detail
+
   /**
    * @brief Execution context for the net_corosio backend.
    *
@@ -40,6 +49,15 @@ namespace vix::net_corosio
     /**
      * @brief Run the event loop (blocking).
      *
+     * With Config::io_threads > 1 the loop also runs on io_threads - 1
+     * internal threads, which are joined before run() returns.
+     * run() may additionally be called concurrently from application threads.
+     *
+     * Tasks are not pinned to a thread: a coroutine may resume on any thread
+     * running the loop, but the steps of one coroutine never run concurrently.
+     * Operations on one Socket issued from a single task are therefore
+     * serialized without locks.
+     *
      * Returns:
      * - Error{none} on clean exit
      * - Error{...} on failure
@@ -58,6 +76,66 @@ namespace vix::net_corosio
      */
     bool stop_requested() const noexcept;
 
+    /**
+     * @brief Returns true while at least one thread is inside run().
+     */
+    bool running() const noexcept;
+
+    /**
+     * @brief Returns true if the calling thread is inside run() for this context.
+     */
+    bool running_in_this_thread() const noexcept;
+
+    /**
+     * @brief Launch a detached task on this context.
+     *
+     * The task starts running the next time the loop is driven
+     * (run() or any blocking wrapper). Errors must be reported through
+     * the task's own results; exceptions escaping the task are dropped.
+     *
+     * The task's own frame was allocated by the caller, from the global
+     * heap, before spawn() sees it; only the launch wrapper and frames the
+     * task creates come from frame_resource(). Use the factory overload to
+     * pool the top-level frame as well.
+     */
+    void spawn(Task<> task);
+
+    /**
+     * @brief Launch make() as a detached task, with its frame pooled.
+     *
+     * make is called once, inside spawn(), after the frame allocator is
+     * installed, so the task frame itself comes from frame_resource().
+     * Prefer this form for tasks spawned at a high rate.
+     */
+    template <class MakeTask>
+      requires std::is_invocable_r_v<Task<>, MakeTask &>
+    void spawn(MakeTask make)
+    {
+      spawn_from([](void *m) -> Task<>
+                 { return (*static_cast<MakeTask *>(m))(); },
+                 &make);
+    }
+
+    /**
+     * @brief Recycling allocator for coroutine frames.
+     *
+     * Internal wrapper tasks allocate their frames here, from per-thread
+     * size-class free lists, so steady-state I/O does not touch the global
+     * heap. Coroutines created while a pooled coroutine runs (children of
+     * spawn()ed tasks, Listener::serve handlers) inherit it; pass it to the
+     * backend's launch function to pool other top-level coroutines.
+     */
+    std::pmr::memory_resource *frame_resource() noexcept;
+
+    /**
+     * @brief Shared I/O buffers for connections on this context.
+     *
+     * Configured by Config::buffer_pool. Acquire a buffer around each
+     * read or write instead of keeping one per connection, and release
+     * every buffer before the Context is destroyed.
+     */
+    BufferPool &buffer_pool() noexcept;
+
     /**
      * @brief Returns an opaque handle for integration.
      *
@@ -66,9 +144,17 @@ namespace vix::net_corosio
      */
     void *native_handle() noexcept;
     const void *native_handle() const noexcept;
+
+    /**
+     * @brief Returns a copyable handle for submitting work to this context.
+     */
     Executor get_executor() noexcept;
 
   private:
+    friend struct detail::ContextAccess;
+
+    void spawn_from(Task<> (*make)(void *), void *state);
+
     struct Impl;
     std::unique_ptr<Impl> impl_;
   };
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <vix/net_corosio/config.hpp>
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/listener.hpp>
+
+namespace vix::net_corosio
+{
+  /**
+   * @brief Shared-nothing pool of single-threaded Contexts, one per core.
+   *
+   * Each Context owns its own event loop and runs on its own thread.
+   * Nothing is shared between them: a connection accepted on a context
+   * lives and dies on that context's thread.
+   *
+   * serve() binds one Listener per context to the same port with
+   * SO_REUSEPORT, so the kernel load-balances accepts with no cross-thread
+   * handoff.
+   *
+   * Lifecycle:
+   * - construct, then serve() and/or spawn work on individual contexts
+   * - run() blocks until every context has stopped
+   * - stop() may be called from any thread
+   */
+  class ContextPool final
+  {
+  public:
+    /**
+     * @brief Create a pool of `size` contexts.
+     *
+     * size = 0 uses std::thread::hardware_concurrency().
+     * Config::io_threads is forced to 1 for every context.
+     * When pin_threads is true, run() pins thread i to CPU i (Linux only).
+     */
+    explicit ContextPool(std::size_t size = 0,
+                         Config cfg = default_config(),
+                         bool pin_threads = false);
+
+    ContextPool(ContextPool &&) noexcept;
+    ContextPool &operator=(ContextPool &&) noexcept;
+
+    ContextPool(const ContextPool &) = delete;
+    ContextPool &operator=(const ContextPool &) = delete;
+
+    ~ContextPool();
+
+    /**
+     * @brief Number of contexts (and threads used by run()).
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * @brief Context at index i (0 <= i < size()).
+     */
+    Context &at(std::size_t i);
+
+    /**
+     * @brief Round-robin pick, e.g. for placing outbound connections.
+     *
+     * Safe to call from any thread. Throws std::out_of_range on a
+     * moved-from pool.
+     */
+    Context &next();
+
+    /**
+     * @brief Context whose loop the calling thread runs, or nullptr.
+     *
+     * Returns nullptr when called from a thread that is not one of this
+     * pool's run() threads.
+     */
+    Context *this_thread_context() noexcept;
+
+    /**
+     * @brief Bind one SO_REUSEPORT listener per context and serve connections.
+     *
+     * Every listener runs Listener::serve(handler) on its own context.
+     * Call before run(). All listeners are bound before any starts
+     * serving; on error the ones already opened are closed and nothing is
+     * served. Listeners are closed when run() returns; each is released
+     * once its serve() coroutine has finished or been destroyed with its
+     * context.
+     *
+     * Port 0 lets the kernel pick a port for the first listener; the
+     * others join it on the same port. Read it back with port().
+     */
+    Error serve(std::uint16_t port, Listener::ConnectionHandler handler, int backlog = 128);
+
+    /**
+     * @brief Port bound by serve(), or 0 before a successful serve().
+     */
+    std::uint16_t port() const noexcept;
+
+    /**
+     * @brief Run every context on its own thread (blocking).
+     *
+     * Context 0 runs on the calling thread. Returns the first error reported
+     * by any context, or Error{none}.
+     */
+    Error run();
+
+    /**
+     * @brief Stop every context.
+     *
+     * Safe to call from any thread.
+     */
+    void stop() noexcept;
+
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+  };
+
+} // namespace vix::net_corosio
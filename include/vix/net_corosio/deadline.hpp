@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace vix::net_corosio
+{
+  /**
+   * @brief Time limit for a single I/O operation.
+   *
+   * A default-constructed Deadline means "use the socket's default timeout"
+   * (see Socket::set_timeout() and Config::io_timeout). An operation whose
+   * deadline passes is cancelled and reports ErrorCode::timeout.
+   */
+  class Deadline final
+  {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Use the socket default.
+     */
+    constexpr Deadline() noexcept = default;
+
+    /**
+     * @brief Expire d from now.
+     */
+    static Deadline after(clock::duration d) noexcept
+    {
+      return at(clock::now() + d);
+    }
+
+    /**
+     * @brief Expire at an absolute point in time.
+     */
+    static constexpr Deadline at(clock::time_point t) noexcept
+    {
+      return Deadline{Kind::at, t};
+    }
+
+    /**
+     * @brief No limit, even if the socket has a default timeout.
+     */
+    static constexpr Deadline never() noexcept
+    {
+      return Deadline{Kind::never, clock::time_point{}};
+    }
+
+    constexpr bool is_default() const noexcept { return kind_ == Kind::use_default; }
+    constexpr bool is_never() const noexcept { return kind_ == Kind::never; }
+
+    /**
+     * @brief Absolute expiry (meaningful only for Deadline::at/after).
+     */
+    constexpr clock::time_point time() const noexcept { return at_; }
+
+  private:
+    enum class Kind : std::uint8_t
+    {
+      use_default = 0,
+      never,
+      at
+    };
+
+    constexpr Deadline(Kind k, clock::time_point t) noexcept
+        : kind_(k), at_(t)
+    {
+    }
+
+    Kind kind_{Kind::use_default};
+    clock::time_point at_{};
+  };
+
+} // namespace vix::net_corosio
@@ -20,6 +20,8 @@ namespace vix::net_corosio
     invalid_argument,
     invalid_state,
     not_initialized,
+    not_supported,
+    canceled,
 
     // Networking
     resolve_failed,
@@ -29,6 +31,8 @@ namespace vix::net_corosio
     write_failed,
     timeout,
     connection_closed,
+    would_block,
+    message_too_large,
 
     // TLS
     tls_handshake_failed,
@@ -82,6 +86,10 @@ namespace vix::net_corosio
       return "invalid_state";
     case ErrorCode::not_initialized:
       return "not_initialized";
+    case ErrorCode::not_supported:
+      return "not_supported";
+    case ErrorCode::canceled:
+      return "canceled";
 
     case ErrorCode::resolve_failed:
       return "resolve_failed";
@@ -97,6 +105,10 @@ namespace vix::net_corosio
       return "timeout";
     case ErrorCode::connection_closed:
       return "connection_closed";
+    case ErrorCode::would_block:
+      return "would_block";
+    case ErrorCode::message_too_large:
+      return "message_too_large";
 
     case ErrorCode::tls_handshake_failed:
       return "tls_handshake_failed";
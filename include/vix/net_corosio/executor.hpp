@@ -1,14 +1,75 @@
 #pragma once
 
+#include <memory>
+#include <type_traits>
+#include <utility>
+
 #include <vix/net_corosio/error.hpp>
 
 namespace vix::net_corosio
 {
+  namespace detail
+  {
+    /**
+     * @brief Type-erased, move-only unit of work.
+     *
+     * Doubles as the intrusive node of the submission queue, so submitting
+     * work costs exactly one allocation (the node holding the callable).
+     */
+    struct WorkItem
+    {
+      WorkItem *next{nullptr};
+
+      // Runs (invoke == true) or discards the work, then frees the node.
+      void (*complete)(WorkItem *self, bool invoke) noexcept {nullptr};
+    };
+
+    template <class F>
+    struct WorkItemImpl final : WorkItem
+    {
+      F fn;
+
+      explicit WorkItemImpl(F &&f)
+          : fn(std::move(f))
+      {
+        complete = &WorkItemImpl::do_complete;
+      }
+
+      static void do_complete(WorkItem *self, bool invoke) noexcept
+      {
+        std::unique_ptr<WorkItemImpl> owned(static_cast<WorkItemImpl *>(self));
+
+        if (!invoke)
+          return;
+
+        try
+        {
+          owned->fn();
+        }
+        catch (...)
+        {
+          // Work items report failures through their own state.
+        }
+      }
+    };
+
+    template <class F>
+    WorkItem *make_work(F &&f)
+    {
+      using Fn = std::decay_t<F>;
+      return new WorkItemImpl<Fn>(Fn(std::forward<F>(f)));
+    }
+  } // namespace detail
+
   /**
    * @brief Backend-agnostic executor handle.
    *
    * Stores an opaque pointer to the backend event-loop context
-   * (currently corosio::io_context).
+   * (currently corosio::io_context) and to the Context's submission queue.
+   *
+   * Executors are cheap to copy and may be used from any thread.
+   * Submitting work from a foreign thread goes through a lock-free
+   * multi-producer queue; the loop is woken once per batch, not per item.
    *
    * Internal .cpp files can recover the real executor via
    * io_context::get_executor().
@@ -18,12 +79,12 @@ namespace vix::net_corosio
   public:
     Executor() = default;
 
+    Executor(const Executor &) = default;
+    Executor &operator=(const Executor &) = default;
+
     Executor(Executor &&) noexcept = default;
     Executor &operator=(Executor &&) noexcept = default;
 
-    Executor(const Executor &) = delete;
-    Executor &operator=(const Executor &) = delete;
-
     ~Executor() = default;
 
     /**
@@ -31,7 +92,60 @@ namespace vix::net_corosio
      */
     bool valid() const noexcept
     {
-      return native_ != nullptr;
+      return native_ != nullptr && sched_ != nullptr;
+    }
+
+    /**
+     * @brief Returns true if the calling thread is running this executor's loop.
+     */
+    bool running_in_this_thread() const noexcept;
+
+    /**
+     * @brief Queue f to run on the loop. Never runs f inline.
+     *
+     * f must be a move-constructible callable taking no arguments.
+     * Exceptions escaping f are dropped.
+     */
+    template <class F>
+    void post(F &&f)
+    {
+      submit(detail::make_work(std::forward<F>(f)));
+    }
+
+    /**
+     * @brief Run f inline if the calling thread runs this loop, otherwise post().
+     */
+    template <class F>
+    void dispatch(F &&f)
+    {
+      if (running_in_this_thread())
+      {
+        std::decay_t<F> fn(std::forward<F>(f));
+        try
+        {
+          fn();
+        }
+        catch (...)
+        {
+        }
+        return;
+      }
+
+      post(std::forward<F>(f));
+    }
+
+    /**
+     * @brief Queue f as a continuation of the current handler.
+     *
+     * Equivalent to post(): there is no separate per-thread queue. The
+     * submission queue already coalesces wakeups, so work deferred from a
+     * handler that runs inside a drain joins the next batch of that drain
+     * without waking the loop again.
+     */
+    template <class F>
+    void defer(F &&f)
+    {
+      post(std::forward<F>(f));
     }
 
     /**
@@ -49,15 +163,23 @@ namespace vix::net_corosio
       return native_;
     }
 
+    friend bool operator==(const Executor &a, const Executor &b) noexcept
+    {
+      return a.sched_ == b.sched_;
+    }
+
   private:
     friend class Context;
 
-    explicit Executor(void *native) noexcept
-        : native_(native)
+    Executor(void *native, void *sched) noexcept
+        : native_(native), sched_(sched)
     {
     }
 
+    void submit(detail::WorkItem *work);
+
     void *native_{nullptr};
+    void *sched_{nullptr};
   };
 
 } // namespace vix::net_corosio
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <vix/net_corosio/buffered_stream.hpp>
+#include <vix/net_corosio/deadline.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/task.hpp>
+
+namespace vix::net_corosio
+{
+  namespace detail
+  {
+    /**
+     * @brief Offset of the first occurrence of needle in haystack, or
+     * std::string_view::npos.
+     *
+     * Scans 32 (AVX2, picked at runtime) or 16 (SSE2) bytes per step,
+     * matching the first and last needle bytes before comparing the rest.
+     */
+    std::size_t find_delimiter(std::string_view haystack, std::string_view needle) noexcept;
+  } // namespace detail
+
+  /**
+   * @brief One frame read by the helpers below.
+   *
+   * data points into the stream's read buffer: it stays valid until the
+   * next read, fill, ensure or consume on that stream. Copy it to keep it.
+   */
+  struct FrameResult final
+  {
+    Error error{};
+    std::string_view data{};
+
+    bool ok() const noexcept { return !error; }
+  };
+
+  /**
+   * @brief Fixed-width unsigned length header for read_frame/write_frame.
+   *
+   * The length counts payload bytes only.
+   */
+  template <std::unsigned_integral T, std::endian Order = std::endian::big>
+  struct LengthPrefix final
+  {
+    static constexpr std::size_t size = sizeof(T);
+
+    static std::size_t decode(const char *p) noexcept
+    {
+      std::uint64_t v = 0;
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        const auto b = static_cast<std::uint64_t>(static_cast<unsigned char>(p[i]));
+        if constexpr (Order == std::endian::big)
+          v = (v << 8) | b;
+        else
+          v |= b << (8 * i);
+      }
+      return static_cast<std::size_t>(v);
+    }
+
+    static void encode(std::size_t n, char *out) noexcept
+    {
+      const auto v = static_cast<std::uint64_t>(static_cast<T>(n));
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        const std::size_t shift = Order == std::endian::big ? 8 * (size - 1 - i) : 8 * i;
+        out[i] = static_cast<char>((v >> shift) & 0xff);
+      }
+    }
+
+    static constexpr std::size_t max_length() noexcept
+    {
+      return static_cast<std::size_t>(static_cast<T>(~T{}));
+    }
+  };
+
+  /**
+   * @brief Read up to and including the first delim.
+   *
+   * Wrap a Socket or TlsStream in a BufferedStream first. Each fill()
+   * only scans the bytes it added. A frame longer than the read buffer
+   * reports message_too_large; end of stream before delim reports
+   * connection_closed. An empty delim reports invalid_argument.
+   */
+  template <class Stream>
+  FrameResult read_until(BufferedStream<Stream> &stream, std::string_view delim, Deadline deadline = {})
+  {
+    if (delim.empty())
+      return FrameResult{Error{ErrorCode::invalid_argument}, {}};
+
+    std::size_t from = 0;
+
+    for (;;)
+    {
+      const std::string_view data = stream.peek();
+
+      const std::size_t at = detail::find_delimiter(data.substr(from), delim);
+      if (at != std::string_view::npos)
+        return FrameResult{Error{ErrorCode::none}, stream.hold(from + at + delim.size())};
+
+      // A delimiter may straddle the bytes the next fill() adds.
+      from = data.size() >= delim.size() ? data.size() - delim.size() + 1 : 0;
+
+      if (stream.buffered() == stream.read_buffer().capacity())
+        return FrameResult{Error{ErrorCode::message_too_large}, {}};
+
+      auto r = stream.fill(deadline);
+      if (!r.ok())
+        return FrameResult{r.error, {}};
+      if (r.bytes == 0)
+        return FrameResult{Error{ErrorCode::connection_closed}, {}};
+    }
+  }
+
+  /**
+   * @brief Read one '\n'-terminated line, without the "\n" or "\r\n".
+   */
+  template <class Stream>
+  FrameResult read_line(BufferedStream<Stream> &stream, Deadline deadline = {})
+  {
+    FrameResult r = read_until(stream, "\n", deadline);
+    if (r.ok())
+    {
+      r.data.remove_suffix(1);
+      if (!r.data.empty() && r.data.back() == '\r')
+        r.data.remove_suffix(1);
+    }
+    return r;
+  }
+
+  /**
+   * @brief Read one length-prefixed frame; data is the payload.
+   *
+   * Header and payload must fit in the read buffer together, else
+   * message_too_large. End of stream inside a frame reports
+   * connection_closed.
+   */
+  template <class Prefix, class Stream>
+  FrameResult read_frame(BufferedStream<Stream> &stream, Deadline deadline = {})
+  {
+    auto h = stream.ensure(Prefix::size, deadline);
+    if (!h.ok())
+      return FrameResult{h.error, {}};
+
+    const std::size_t length = Prefix::decode(stream.peek().data());
+    if (length > stream.read_buffer().capacity() - Prefix::size)
+      return FrameResult{Error{ErrorCode::message_too_large}, {}};
+
+    auto r = stream.ensure(Prefix::size + length, deadline);
+    if (!r.ok())
+      return FrameResult{r.error, {}};
+
+    return FrameResult{Error{ErrorCode::none}, stream.hold(Prefix::size + length).substr(Prefix::size)};
+  }
+
+  /**
+   * @brief Queue one length-prefixed frame with write(); flush() to send.
+   *
+   * A payload longer than Prefix can encode reports message_too_large.
+   */
+  template <class Prefix, class Stream>
+  auto write_frame(BufferedStream<Stream> &stream, std::string_view payload, Deadline deadline = {})
+      -> typename BufferedStream<Stream>::result_type
+  {
+    using result_type = typename BufferedStream<Stream>::result_type;
+
+    if (payload.size() > Prefix::max_length())
+      return result_type{Error{ErrorCode::message_too_large}, 0};
+
+    char header[Prefix::size];
+    Prefix::encode(payload.size(), header);
+
+    auto h = stream.write(header, sizeof(header), deadline);
+    if (!h.ok())
+      return result_type{h.error, 0};
+
+    return stream.write(payload.data(), payload.size(), deadline);
+  }
+
+  /**
+   * @brief Awaitable form of read_until().
+   *
+   * delim is taken by value so the task may outlive the caller's string.
+   */
+  template <class Stream>
+  Task<FrameResult> async_read_until(BufferedStream<Stream> &stream, std::string delim, Deadline deadline = {})
+  {
+    if (delim.empty())
+      co_return FrameResult{Error{ErrorCode::invalid_argument}, {}};
+
+    std::size_t from = 0;
+
+    for (;;)
+    {
+      const std::string_view data = stream.peek();
+
+      const std::size_t at = detail::find_delimiter(data.substr(from), delim);
+      if (at != std::string_view::npos)
+        co_return FrameResult{Error{ErrorCode::none}, stream.hold(from + at + delim.size())};
+
+      from = data.size() >= delim.size() ? data.size() - delim.size() + 1 : 0;
+
+      if (stream.buffered() == stream.read_buffer().capacity())
+        co_return FrameResult{Error{ErrorCode::message_too_large}, {}};
+
+      auto r = co_await stream.async_fill(deadline);
+      if (!r.ok())
+        co_return FrameResult{r.error, {}};
+      if (r.bytes == 0)
+        co_return FrameResult{Error{ErrorCode::connection_closed}, {}};
+    }
+  }
+
+  /**
+   * @brief Awaitable form of read_line().
+   */
+  template <class Stream>
+  Task<FrameResult> async_read_line(BufferedStream<Stream> &stream, Deadline deadline = {})
+  {
+    FrameResult r = co_await async_read_until(stream, "\n", deadline);
+    if (r.ok())
+    {
+      r.data.remove_suffix(1);
+      if (!r.data.empty() && r.data.back() == '\r')
+        r.data.remove_suffix(1);
+    }
+    co_return r;
+  }
+
+  /**
+   * @brief Awaitable form of read_frame().
+   */
+  template <class Prefix, class Stream>
+  Task<FrameResult> async_read_frame(BufferedStream<Stream> &stream, Deadline deadline = {})
+  {
+    auto h = co_await stream.async_ensure(Prefix::size, deadline);
+    if (!h.ok())
+      co_return FrameResult{h.error, {}};
+
+    const std::size_t length = Prefix::decode(stream.peek().data());
+    if (length > stream.read_buffer().capacity() - Prefix::size)
+      co_return FrameResult{Error{ErrorCode::message_too_large}, {}};
+
+    auto r = co_await stream.async_ensure(Prefix::size + length, deadline);
+    if (!r.ok())
+      co_return FrameResult{r.error, {}};
+
+    co_return FrameResult{Error{ErrorCode::none}, stream.hold(Prefix::size + length).substr(Prefix::size)};
+  }
+
+  /**
+   * @brief Awaitable form of write_frame().
+   */
+  template <class Prefix, class Stream>
+  auto async_write_frame(BufferedStream<Stream> &stream, std::string_view payload, Deadline deadline = {})
+      -> Task<typename BufferedStream<Stream>::result_type>
+  {
+    using result_type = typename BufferedStream<Stream>::result_type;
+
+    if (payload.size() > Prefix::max_length())
+      co_return result_type{Error{ErrorCode::message_too_large}, 0};
+
+    char header[Prefix::size];
+    Prefix::encode(payload.size(), header);
+
+    auto h = co_await stream.async_write(header, sizeof(header), deadline);
+    if (!h.ok())
+      co_return result_type{h.error, 0};
+
+    co_return co_await stream.async_write(payload.data(), payload.size(), deadline);
+  }
+
+} // namespace vix::net_corosio
@@ -2,9 +2,13 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <string>
 
 #include <vix/net_corosio/error.hpp>
 #include <vix/net_corosio/socket.hpp>
+#include <vix/net_corosio/socket_options.hpp>
+#include <vix/net_corosio/task.hpp>
 
 namespace vix::net_corosio
 {
@@ -46,12 +50,66 @@ namespace vix::net_corosio
     Error open();
 
     /**
-     * @brief Bind to a local port (IPv4 any by default).
+     * @brief Allow several listeners to bind the same port (SO_REUSEPORT).
      *
-     * If you need to bind to a specific address later, we can extend this API.
+     * The kernel then load-balances incoming connections across them.
+     * Must be called after open() and before bind().
+     * Returns not_supported where SO_REUSEPORT is unavailable.
+     */
+    Error set_reuse_port(bool enabled);
+
+    /**
+     * @brief Accept data in SYN packets (TCP Fast Open).
+     *
+     * queue_length bounds connections with pending Fast Open data. Must be
+     * called after open() and before listen(). On Linux the system-wide
+     * net.ipv4.tcp_fastopen setting must include server support (bit 0x2).
+     * Returns not_supported where TCP_FASTOPEN is unavailable.
+     */
+    Error set_fast_open(int queue_length);
+
+    /**
+     * @brief Options for the listening socket and every socket it accepts.
+     *
+     * Applied to the listener when open (or, best effort, by open()), and to each accepted
+     * socket on top of Config::socket_options. Kernel inheritance of options
+     * across accept() differs between platforms; net_corosio applies them
+     * explicitly.
+     */
+    Error set_options(const SocketOptions &opts);
+
+    /**
+     * @brief Bind to a local port on the IPv4 wildcard address.
+     *
+     * Port 0 picks an ephemeral port; read it back with local_endpoint().
      */
     Error bind(std::uint16_t port);
 
+    /**
+     * @brief Bind to a specific address: "0.0.0.0", "::", "127.0.0.1",
+     * "::1", "[fe80::1]", ... An empty address is the IPv4 wildcard.
+     *
+     * The listener is (re)opened for the address family, replaying
+     * options, reuse_port, v6_only and fast_open set since open().
+     * Binding "::" gives a dual-stack listener unless set_v6_only(true).
+     * Returns not_supported for IPv6 addresses on backends that can only
+     * open IPv4 sockets.
+     */
+    Error bind(const TcpEndpoint &ep);
+
+    /**
+     * @brief IPV6_V6ONLY for IPv6 listeners: accept IPv6 only (true) or
+     * IPv4-mapped connections too (false). The system default applies
+     * when never called. Must be called before bind().
+     */
+    Error set_v6_only(bool enabled);
+
+    /**
+     * @brief Bound address and port (the actual port after bind(0)).
+     * Empty before bind().
+     */
+    TcpEndpoint local_endpoint() const;
+
     /**
      * @brief Start listening.
      */
@@ -78,6 +136,39 @@ namespace vix::net_corosio
 
     AcceptResult accept();
 
+    /**
+     * @brief Awaitable form of accept().
+     */
+    Task<AcceptResult> async_accept();
+
+    /**
+     * @brief Per-connection coroutine started by serve().
+     *
+     * The handler owns the accepted socket for the lifetime of the task.
+     */
+    using ConnectionHandler = std::function<Task<>(Socket)>;
+
+    /**
+     * @brief Accept connections continuously and run one handler task per connection.
+     *
+     * A new accept is posted as soon as the previous one completes, as long as
+     * fewer than max_in_flight handlers are running. When the limit is reached
+     * the loop waits for a handler to finish before accepting again, which keeps
+     * memory use bounded under bursts.
+     *
+     * max_in_flight = 0 uses Config::max_workers; if that is also 0 the number
+     * of concurrent handlers is unbounded.
+     *
+     * Accept errors of a single pending connection (aborted or reset by the
+     * peer) are skipped. Resource exhaustion (EMFILE, ENFILE, ENOBUFS, ENOMEM)
+     * and network-down errors are retried after a backoff that starts at 5 ms,
+     * doubles up to 1 s and resets on the next successful accept.
+     *
+     * Returns Error{none} once the listener is closed, or the first fatal
+     * accept error that stopped the loop. Handlers still running at that point run to completion.
+     */
+    Task<Error> serve(ConnectionHandler handler, std::size_t max_in_flight = 0);
+
     /**
      * @brief Close the listener (safe to call multiple times).
      */
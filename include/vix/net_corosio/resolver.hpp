@@ -7,6 +7,7 @@
 #include <vector>
 
 #include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/task.hpp>
 
 namespace vix::net_corosio
 {
@@ -81,6 +82,14 @@ namespace vix::net_corosio
      */
     ResolveResult resolve(std::string_view host, std::string_view service);
 
+    /**
+     * @brief Resolve without blocking the loop (same results as resolve()).
+     *
+     * Endpoints keep the system's preference order (RFC 6724), which
+     * Socket::connect_any() relies on.
+     */
+    Task<ResolveResult> async_resolve(std::string host, std::string service);
+
   private:
     struct Impl;
     Impl *impl_{nullptr};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include <vix/net_corosio/buffer.hpp>
+
+namespace vix::net_corosio
+{
+  /**
+   * @brief Byte FIFO whose readable and writable regions are always
+   * contiguous, so a parser can look at everything received as one view
+   * and a read can fill all free space at once.
+   *
+   * Two layouts:
+   * - compact (default): one allocation; prepare() moves the unread bytes
+   *   to the front when they are not there already. Parsers consume
+   *   almost everything they read, so the move is usually small.
+   * - mirrored (Linux): the same pages are mapped twice back to back, so
+   *   data wraps around with no copy at all. Capacity is rounded up to
+   *   the page size and each buffer costs two mappings; worth it for
+   *   large buffers with long-lived partial data.
+   *
+   * Not thread-safe.
+   */
+  class RingBuffer final
+  {
+  public:
+    /**
+     * @brief Allocate capacity bytes (at least 1).
+     *
+     * mirror is a request: when the platform cannot map the buffer twice
+     * the compact layout is used; see mirrored().
+     */
+    explicit RingBuffer(std::size_t capacity, bool mirror = false);
+
+    RingBuffer(RingBuffer &&other) noexcept;
+    RingBuffer &operator=(RingBuffer &&other) noexcept;
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+    ~RingBuffer();
+
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    /**
+     * @brief Readable bytes.
+     */
+    std::size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Free bytes (capacity() - size()).
+     */
+    std::size_t space() const noexcept { return capacity_ - size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+    bool full() const noexcept { return size_ == capacity_; }
+    bool mirrored() const noexcept { return mirrored_; }
+
+    /**
+     * @brief All readable bytes, contiguous.
+     */
+    ConstBuffer data() const noexcept;
+
+    /**
+     * @brief data() as characters, for parsing.
+     */
+    std::string_view view() const noexcept;
+
+    /**
+     * @brief All free space, contiguous. Fill it, then commit().
+     *
+     * Invalidates views returned by data()/view() in the compact layout.
+     */
+    MutableBuffer prepare() noexcept;
+
+    /**
+     * @brief Make n bytes written into prepare() readable.
+     */
+    void commit(std::size_t n) noexcept;
+
+    /**
+     * @brief Drop n readable bytes from the front.
+     */
+    void consume(std::size_t n) noexcept;
+
+    void clear() noexcept;
+
+  private:
+    void release() noexcept;
+
+    char *base_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t head_{0}; // offset of the first readable byte
+    std::size_t size_{0};
+    bool mirrored_{false};
+  };
+
+} // namespace vix::net_corosio
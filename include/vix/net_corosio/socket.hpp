@@ -1,11 +1,18 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <string_view>
 
+#include <vix/net_corosio/buffer.hpp>
+#include <vix/net_corosio/deadline.hpp>
 #include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/resolver.hpp>
+#include <vix/net_corosio/socket_options.hpp>
+#include <vix/net_corosio/task.hpp>
 
 namespace vix::net_corosio
 {
@@ -25,7 +32,10 @@ namespace vix::net_corosio
    * @brief TCP connection endpoint.
    *
    * This is intentionally minimal: address string + port.
-   * Parsing/validation is performed in the implementation layer.
+   * Parsing/validation is performed in the implementation layer:
+   * address is "localhost", an IPv4 literal ("10.0.0.1") or an IPv6
+   * literal ("::1", brackets optional: "[::1]"). Host names go through
+   * Resolver first.
    */
   struct TcpEndpoint final
   {
@@ -52,6 +62,20 @@ namespace vix::net_corosio
    * - explicit error model
    * - no backend types in public headers
    * - no hidden allocations policy (caller owns buffers)
+   *
+   * Every operation exists in two forms:
+   * - blocking (connect/read_some/write_some): drives the Context loop
+   *   on the calling thread until the operation completes
+   * - awaitable (async_*): returns a Task, so many sockets can share
+   *   one Context and one thread
+   *
+   * Every operation accepts a Deadline; by default the socket's timeout()
+   * applies. An operation that misses its deadline is cancelled and reports
+   * ErrorCode::timeout. After a timeout the connection state is unspecified
+   * (bytes may have been partially transferred) and it should be closed.
+   *
+   * The Socket must outlive any pending awaitable operation and must not
+   * be moved while one is in flight.
    */
   class Socket final
   {
@@ -73,25 +97,329 @@ namespace vix::net_corosio
 
     /**
      * @brief Open the socket (idempotent).
+     *
+     * Applies the stored options best effort; call set_options() on the
+     * open socket to see which ones failed.
      */
     Error open();
 
     /**
-     * @brief Connect to a TCP endpoint.
+     * @brief Connect to a TCP endpoint (IPv4 or IPv6).
+     *
+     * Opens the socket for the endpoint's address family if needed. A
+     * socket opened with open() (IPv4) is reopened for an IPv6 target,
+     * re-applying its options. Returns not_supported for an IPv6 target
+     * on backends that can only open IPv4 sockets.
+     */
+    Error connect(const TcpEndpoint &ep, Deadline deadline = {});
+
+    /**
+     * @brief Connect to the first reachable endpoint of a resolution
+     * (Happy Eyeballs, RFC 8305).
+     *
+     * Addresses are interleaved by family, keeping the resolver's
+     * preference order. Attempts start one at a time, the next one
+     * Config::connect_attempt_delay after the previous (or as soon as it
+     * fails), and run concurrently; the first to connect wins and the
+     * others are cancelled. The socket keeps its options and timeout.
+     *
+     * The deadline covers the whole race. On failure the error of the
+     * last attempt to finish is returned.
+     *
+     * The winning attempt's state replaces this socket's, so wrap the
+     * socket in a TlsStream only after connect_any() returns: a stream
+     * created earlier keeps referring to the replaced state.
+     */
+    Error connect_any(const ResolveResult &resolved, Deadline deadline = {});
+
+    /**
+     * @brief Resolve host and service, then connect_any().
+     *
+     * The deadline covers the attempts, not name resolution. As with
+     * connect_any(), create any TlsStream over the socket afterwards.
+     */
+    Error connect(std::string_view host, std::string_view service, Deadline deadline = {});
+
+    /**
+     * @brief Connect and send the first bytes, in the SYN when possible.
+     *
+     * Uses TCP Fast Open: with a cookie cached from an earlier connection
+     * to the same server (and a server that enabled it, see
+     * Listener::set_fast_open()), data rides in the SYN and the request
+     * reaches the server one round trip earlier. Otherwise the kernel does
+     * a regular handshake and sends data right after, so the result is the
+     * same either way.
      *
-     * Requires: open() (or will open implicitly if strict_checks=false).
+     * Write semantics are those of write_some(): bytes may be less than
+     * size. The deadline covers connect and write together.
      */
-    Error connect(const TcpEndpoint &ep);
+    IoResult connect_with_data(const TcpEndpoint &ep, const void *data, std::size_t size,
+                               Deadline deadline = {});
 
     /**
      * @brief Read some bytes into caller-provided buffer.
      */
-    IoResult read_some(void *data, std::size_t size);
+    IoResult read_some(void *data, std::size_t size, Deadline deadline = {});
 
     /**
      * @brief Write some bytes from caller-provided buffer.
+     *
+     * Performs one send: waits until the socket is writable, then returns
+     * as soon as the kernel accepts any bytes. bytes may be less than size;
+     * use write_all() to send everything.
+     */
+    IoResult write_some(const void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Scatter read: fill buffers in order with one readv().
+     *
+     * The buffer descriptors and the memory they point to must stay valid
+     * until the operation completes.
+     */
+    IoResult read_some(std::span<const MutableBuffer> buffers, Deadline deadline = {});
+
+    /**
+     * @brief Gather write: send buffers in order with one writev().
+     *
+     * Avoids copying a header and a body into a staging buffer.
+     */
+    IoResult write_some(std::span<const ConstBuffer> buffers, Deadline deadline = {});
+
+    /**
+     * @brief Write the whole buffer, looping over write_some().
+     *
+     * The deadline covers the entire transfer. On failure bytes reports
+     * how much was sent before the error.
+     */
+    IoResult write_all(const void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Gather form of write_all().
+     */
+    IoResult write_all(std::span<const ConstBuffer> buffers, Deadline deadline = {});
+
+    /**
+     * @brief Read exactly size bytes, looping over read_some().
+     *
+     * Reports connection_closed if the peer closes first; bytes then holds
+     * what was received.
+     */
+    IoResult read_exact(void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of connect().
+     *
+     * The endpoint is taken by value so the task may outlive the caller's copy.
+     */
+    Task<Error> async_connect(TcpEndpoint ep, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of connect_any().
+     */
+    Task<Error> async_connect_any(ResolveResult resolved, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of connect(host, service).
+     */
+    Task<Error> async_connect(std::string host, std::string service, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of connect_with_data().
+     */
+    Task<IoResult> async_connect_with_data(TcpEndpoint ep, const void *data, std::size_t size,
+                                           Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of read_some().
+     */
+    Task<IoResult> async_read_some(void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of write_some().
+     */
+    Task<IoResult> async_write_some(const void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable scatter read.
+     */
+    Task<IoResult> async_read_some(std::span<const MutableBuffer> buffers, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable gather write.
+     */
+    Task<IoResult> async_write_some(std::span<const ConstBuffer> buffers, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of write_all().
+     */
+    Task<IoResult> async_write_all(const void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable gather form of write_all().
+     */
+    Task<IoResult> async_write_all(std::span<const ConstBuffer> buffers, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of read_exact().
      */
-    IoResult write_some(const void *data, std::size_t size);
+    Task<IoResult> async_read_exact(void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Read whatever the kernel already holds, without waiting.
+     *
+     * Never touches the event loop, so it is safe to call in a loop that
+     * drains many sockets after one readiness wakeup.
+     * Returns would_block when no data is pending and connection_closed on
+     * orderly EOF.
+     */
+    IoResult try_read_some(void *data, std::size_t size);
+
+    /**
+     * @brief Write as much as the kernel accepts right now, without waiting.
+     *
+     * Never touches the event loop. May write fewer than size bytes;
+     * returns would_block when the send buffer is full.
+     */
+    IoResult try_write_some(const void *data, std::size_t size);
+
+    /**
+     * @brief Scatter/gather forms of try_read_some()/try_write_some().
+     */
+    IoResult try_read_some(std::span<const MutableBuffer> buffers);
+    IoResult try_write_some(std::span<const ConstBuffer> buffers);
+
+    /**
+     * @brief Wait until a read would not block, without a caller buffer.
+     *
+     * Completes when data, EOF or an error is pending, so an idle
+     * connection can wait with no receive buffer and take one from
+     * Context::buffer_pool() only once bytes arrive. Nothing is read: the
+     * bytes, EOF or error are left for the next read to report, so the
+     * wait also works below a TlsStream. A TlsStream may already hold
+     * decrypted bytes the socket no longer shows; read it with a buffer of
+     * at least one record (16 KiB) before waiting on its socket.
+     *
+     * The backend reactor only completes reads and writes, so a parked
+     * wait is registered with a per-Context epoll thread instead; it
+     * costs no timer and no loop wakeup until the socket is ready.
+     * Returns not_supported where that is unavailable (non-Linux).
+     */
+    Error wait_readable(Deadline deadline = {});
+
+    /**
+     * @brief Wait until a write would not block, without writing.
+     *
+     * Meant for back-pressure after would_block. Parked the same way as
+     * wait_readable(), with the same platform support. A close() from
+     * another task completes either wait with connection_closed.
+     */
+    Error wait_writable(Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of wait_readable().
+     */
+    Task<Error> async_wait_readable(Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of wait_writable().
+     */
+    Task<Error> async_wait_writable(Deadline deadline = {});
+
+    /**
+     * @brief Send file contents without copying them through user space.
+     *
+     * file_fd is a regular file (sendfile(), from offset) or a pipe
+     * (splice(); offset must be 0). length 0 means "to end of file".
+     * On back-pressure the transfer parks until the socket drains (see
+     * wait_writable()) and resumes with the same syscall, so no byte is
+     * copied through user space; the deadline covers the whole transfer. bytes reports how
+     * much reached the socket, also on error. A file shorter than length
+     * reports read_failed. file_fd stays owned by the caller.
+     *
+     * Platforms without sendfile()/splice() fall back to bounded
+     * read-and-write copies; Windows reports not_supported.
+     */
+    IoResult send_file(int file_fd, std::uint64_t offset = 0, std::size_t length = 0,
+                       Deadline deadline = {});
+
+    /**
+     * @brief Open path read-only and send it (see send_file(int, ...)).
+     *
+     * Reports invalid_argument if the file cannot be opened.
+     */
+    IoResult send_file(const std::string &path, std::uint64_t offset = 0, std::size_t length = 0,
+                       Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of send_file().
+     */
+    Task<IoResult> async_send_file(int file_fd, std::uint64_t offset = 0, std::size_t length = 0,
+                                   Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of send_file(path, ...).
+     *
+     * The path is taken by value so the task may outlive the caller's copy.
+     */
+    Task<IoResult> async_send_file(std::string path, std::uint64_t offset = 0, std::size_t length = 0,
+                                   Deadline deadline = {});
+
+    /**
+     * @brief Local address and port (e.g. the ephemeral port picked by
+     * connect()). Empty if the socket is closed.
+     */
+    TcpEndpoint local_endpoint() const;
+
+    /**
+     * @brief Peer address and port. Empty unless connected.
+     */
+    TcpEndpoint remote_endpoint() const;
+
+    /**
+     * @brief Apply the fields set in opts and remember them.
+     *
+     * On a closed socket the options are stored and applied by open().
+     * Every field is attempted; the first failure is returned (not_supported
+     * for options the platform lacks).
+     */
+    Error set_options(const SocketOptions &opts);
+
+    /**
+     * @brief Options set so far (Config::socket_options merged with
+     * set_options() calls and, for accepted sockets, the listener's).
+     */
+    SocketOptions options() const;
+
+    /**
+     * @brief Send large write_all() payloads with MSG_ZEROCOPY.
+     *
+     * Applies to contiguous write_all()/async_write_all() calls of at least
+     * Config::zero_copy_min_bytes. The kernel sends straight from the
+     * caller's pages; the call returns once every page has been released,
+     * so buffer ownership is the same as without zero copy. Without a
+     * deadline that wait is bounded by timeout(), or 10 seconds when no
+     * timeout is set. If the operation times out, pages may still be
+     * pinned: do not modify the buffer until the socket is closed.
+     *
+     * Requires an open socket. The setting is re-applied when the socket
+     * is reopened (e.g. connect() switching to IPv6); if that fails,
+     * writes copy as usual. Returns not_supported where the platform has
+     * no SO_ZEROCOPY (Linux 4.14+ only).
+     */
+    Error set_zero_copy(bool enable);
+
+    /**
+     * @brief True if zero-copy sends are enabled.
+     */
+    bool zero_copy() const noexcept;
+
+    /**
+     * @brief Default deadline for operations called without one.
+     *
+     * Initialized from Config::io_timeout. 0 disables the default.
+     */
+    void set_timeout(std::chrono::milliseconds timeout) noexcept;
+    std::chrono::milliseconds timeout() const noexcept;
 
     /**
      * @brief Close the socket (safe to call multiple times).
@@ -107,7 +435,18 @@ namespace vix::net_corosio
     const void *native_handle() const noexcept;
     void *io_context_handle() noexcept;
 
+    /**
+     * @brief Context this socket was created on (nullptr if moved-from).
+     */
+    Context *context() noexcept;
+
   private:
+    friend class Listener;
+    friend class TlsStream;
+
+    // Accepted sockets are connected without going through connect().
+    void mark_connected() noexcept;
+
     struct Impl;
     Impl *impl_{nullptr};
   };
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace vix::net_corosio
+{
+  /**
+   * @brief TCP keepalive probes (SO_KEEPALIVE and its timings).
+   *
+   * Zero timings keep the system default.
+   */
+  struct KeepAlive final
+  {
+    bool enabled{true};
+    std::chrono::seconds idle{0};     // TCP_KEEPIDLE: quiet time before the first probe
+    std::chrono::seconds interval{0}; // TCP_KEEPINTVL: time between probes
+    int probes{0};                    // TCP_KEEPCNT: unanswered probes before the peer is dead
+  };
+
+  /**
+   * @brief Typed socket options.
+   *
+   * Every field is optional: an empty field leaves the kernel setting
+   * untouched, so option sets can be layered (Config default, then
+   * listener, then per socket) with merge().
+   */
+  struct SocketOptions final
+  {
+    /**
+     * @brief TCP_NODELAY: send small segments immediately (disable Nagle).
+     */
+    std::optional<bool> no_delay{};
+
+    /**
+     * @brief SO_SNDBUF / SO_RCVBUF in bytes (the kernel may round or double them).
+     *
+     * Set the receive buffer on a Listener before listen() so the window
+     * scale negotiated by accepted connections accounts for it.
+     */
+    std::optional<std::size_t> send_buffer_bytes{};
+    std::optional<std::size_t> receive_buffer_bytes{};
+
+    std::optional<KeepAlive> keep_alive{};
+
+    /**
+     * @brief TCP_QUICKACK: acknowledge immediately instead of delaying ACKs.
+     *
+     * Linux clears this flag after it sends an ACK, so net_corosio sets it
+     * again after each successful read while it is enabled.
+     */
+    std::optional<bool> quick_ack{};
+
+    /**
+     * @brief TCP_CORK (TCP_NOPUSH on BSD): hold partial segments until
+     * uncorked, so a header and a body written separately leave as full
+     * segments. Uncorking flushes.
+     */
+    std::optional<bool> cork{};
+
+    /**
+     * @brief TCP_CONGESTION algorithm name, e.g. "cubic" or "bbr".
+     *
+     * An algorithm the kernel does not provide reports not_supported.
+     */
+    std::optional<std::string> congestion{};
+
+    /**
+     * @brief TCP_NOTSENT_LOWAT: cap on unsent bytes queued in the kernel.
+     *
+     * Keeps the send buffer from hiding backpressure; writes report
+     * would_block earlier and latency-sensitive data is not stuck behind
+     * a long queue.
+     */
+    std::optional<std::size_t> not_sent_lowat{};
+
+    /**
+     * @brief Overlay the fields set in other onto this set.
+     */
+    SocketOptions &merge(const SocketOptions &other)
+    {
+      if (other.no_delay)
+        no_delay = other.no_delay;
+      if (other.send_buffer_bytes)
+        send_buffer_bytes = other.send_buffer_bytes;
+      if (other.receive_buffer_bytes)
+        receive_buffer_bytes = other.receive_buffer_bytes;
+      if (other.keep_alive)
+        keep_alive = other.keep_alive;
+      if (other.quick_ack)
+        quick_ack = other.quick_ack;
+      if (other.cork)
+        cork = other.cork;
+      if (other.congestion)
+        congestion = other.congestion;
+      if (other.not_sent_lowat)
+        not_sent_lowat = other.not_sent_lowat;
+      return *this;
+    }
+
+    /**
+     * @brief True if no field is set.
+     */
+    bool empty() const noexcept
+    {
+      return !no_delay && !send_buffer_bytes && !receive_buffer_bytes && !keep_alive &&
+             !quick_ack && !cork && !congestion && !not_sent_lowat;
+    }
+  };
+
+} // namespace vix::net_corosio
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <vix/net_corosio/executor.hpp>
+
+namespace vix::net_corosio
+{
+  namespace detail
+  {
+    class StrandState;
+  } // namespace detail
+
+  /**
+   * @brief Serializes work submitted through it, on top of an Executor.
+   *
+   * Work items posted to one strand never run concurrently and run in
+   * submission order, even when the Context loop runs on several threads.
+   * This gives per-connection ordering without a mutex around the
+   * connection state.
+   *
+   * Handoff between threads is lock-free: the first submitter to find the
+   * strand idle takes ownership and schedules one drain on the executor;
+   * everyone else just enqueues. dispatch() from a loop thread runs inline,
+   * without queueing or allocating, when the strand is uncontended.
+   *
+   * Strands are cheap to copy; copies refer to the same strand.
+   */
+  class Strand final
+  {
+  public:
+    explicit Strand(Executor ex);
+
+    Strand(const Strand &) = default;
+    Strand &operator=(const Strand &) = default;
+
+    Strand(Strand &&) noexcept = default;
+    Strand &operator=(Strand &&) noexcept = default;
+
+    ~Strand() = default;
+
+    /**
+     * @brief Underlying executor.
+     */
+    const Executor &get_executor() const noexcept;
+
+    /**
+     * @brief Returns true if the calling thread is currently running work of this strand.
+     */
+    bool running_in_this_thread() const noexcept;
+
+    /**
+     * @brief Queue f to run on the strand. Never runs f inline.
+     */
+    template <class F>
+    void post(F &&f)
+    {
+      submit(detail::make_work(std::forward<F>(f)));
+    }
+
+    /**
+     * @brief Run f inline when allowed, otherwise post().
+     *
+     * Inline execution happens when the calling thread is already inside
+     * this strand, or when it runs the executor's loop and the strand is idle.
+     */
+    template <class F>
+    void dispatch(F &&f)
+    {
+      if (running_in_this_thread())
+      {
+        invoke(f);
+        return;
+      }
+
+      if (try_enter())
+      {
+        invoke(f);
+        leave();
+        return;
+      }
+
+      post(std::forward<F>(f));
+    }
+
+    friend bool operator==(const Strand &a, const Strand &b) noexcept
+    {
+      return a.state_ == b.state_;
+    }
+
+  private:
+    template <class F>
+    static void invoke(F &f) noexcept
+    {
+      try
+      {
+        f();
+      }
+      catch (...)
+      {
+        // Same policy as Executor: failures travel through the work's own state.
+      }
+    }
+
+    void submit(detail::WorkItem *work);
+
+    // Take the strand for inline execution on a loop thread, if it is idle.
+    bool try_enter() noexcept;
+
+    // Release after inline execution; hands queued work to a drain.
+    void leave() noexcept;
+
+    std::shared_ptr<detail::StrandState> state_;
+  };
+
+} // namespace vix::net_corosio
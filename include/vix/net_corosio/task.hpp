@@ -0,0 +1,20 @@
+#pragma once
+
+#include <boost/capy/task.hpp>
+
+namespace vix::net_corosio
+{
+  /**
+   * @brief Coroutine type returned by the awaitable API.
+   *
+   * This is the one place where a backend type is exposed on purpose:
+   * an awaitable has to be a concrete coroutine type, and aliasing it here
+   * keeps call sites spelled in net_corosio terms.
+   *
+   * Tasks are lazy. They start when awaited, or when handed to
+   * Context::spawn().
+   */
+  template <class T = void>
+  using Task = boost::capy::task<T>;
+
+} // namespace vix::net_corosio
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/task.hpp>
+
+namespace vix::net_corosio
+{
+  class Context;
+
+  /**
+   * @brief Steady-clock timer bound to a Context.
+   *
+   * Timers live in a per-Context hierarchical timing wheel with 1 ms
+   * resolution: arming and cancelling are O(1) no matter how many timers are
+   * armed, which makes per-connection idle timeouts and deadlines cheap.
+   *
+   * A timer supports one wait at a time. Waits never complete early; they
+   * complete with Error{none} on expiry or Error{canceled} when cancelled.
+   * The timer must outlive any wait in progress.
+   */
+  class Timer final
+  {
+  public:
+    using clock = std::chrono::steady_clock;
+    using duration = clock::duration;
+    using time_point = clock::time_point;
+
+    explicit Timer(Context &ctx);
+
+    Timer(Timer &&) noexcept;
+    Timer &operator=(Timer &&) noexcept;
+
+    Timer(const Timer &) = delete;
+    Timer &operator=(const Timer &) = delete;
+
+    ~Timer();
+
+    /**
+     * @brief Set the expiry relative to now. Cancels a pending wait.
+     *
+     * Returns the number of waits cancelled (0 or 1).
+     */
+    std::size_t expires_after(duration d);
+
+    /**
+     * @brief Set an absolute expiry. Cancels a pending wait.
+     *
+     * Returns the number of waits cancelled (0 or 1).
+     */
+    std::size_t expires_at(time_point t);
+
+    /**
+     * @brief Current expiry (epoch of the clock until one is set).
+     */
+    time_point expiry() const noexcept;
+
+    /**
+     * @brief Wait for the expiry (blocking).
+     */
+    Error wait();
+
+    /**
+     * @brief Wait for the expiry.
+     *
+     * Completes immediately when the expiry is already in the past.
+     */
+    Task<Error> async_wait();
+
+    /**
+     * @brief Cancel a pending wait, which completes with Error{canceled}.
+     *
+     * Safe to call from any thread. Returns the number of waits cancelled
+     * (0 or 1); 0 also when the wait is already completing with expiry.
+     */
+    std::size_t cancel() noexcept;
+
+  private:
+    struct Impl;
+    Impl *impl_{nullptr};
+  };
+
+} // namespace vix::net_corosio
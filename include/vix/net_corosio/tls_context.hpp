@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -89,6 +90,11 @@ namespace vix::net_corosio
      */
     Error set_hostname(std::string_view hostname);
 
+    /**
+     * @brief SNI hostname set with set_hostname(), or empty.
+     */
+    std::string_view hostname() const noexcept;
+
     /**
      * @brief Use system default CA store.
      */
@@ -126,6 +132,11 @@ namespace vix::net_corosio
      */
     Error set_alpn(const std::vector<std::string> &protocols);
 
+    /**
+     * @brief ALPN protocols set with set_alpn(), in preference order.
+     */
+    std::span<const std::string> alpn() const noexcept;
+
     /**
      * @brief Set minimum TLS version.
      */
@@ -2,9 +2,13 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 
+#include <vix/net_corosio/buffer.hpp>
+#include <vix/net_corosio/deadline.hpp>
 #include <vix/net_corosio/error.hpp>
 #include <vix/net_corosio/socket.hpp>
+#include <vix/net_corosio/task.hpp>
 #include <vix/net_corosio/tls_context.hpp>
 
 namespace vix::net_corosio
@@ -27,6 +31,14 @@ namespace vix::net_corosio
    *
    * This wrapper keeps the public API stable while allowing different
    * TLS backends internally (wolfSSL, OpenSSL, etc.), depending on Corosio.
+   *
+   * Like Socket, every operation has a blocking form and an awaitable
+   * async_* form. Awaitable handshakes let many TLS sessions overlap
+   * on one Context.
+   *
+   * Handshake, read and write accept a Deadline; by default the underlying
+   * socket's timeout() applies. On expiry the TCP operation is cancelled and
+   * ErrorCode::timeout is returned; the TLS session is then unusable.
    */
   class TlsStream final
   {
@@ -50,25 +62,106 @@ namespace vix::net_corosio
     /**
      * @brief Perform TLS handshake.
      */
-    Error handshake();
+    Error handshake(Deadline deadline = {});
 
     /**
      * @brief Read some decrypted bytes.
      */
-    TlsIoResult read_some(void *data, std::size_t size);
+    TlsIoResult read_some(void *data, std::size_t size, Deadline deadline = {});
 
     /**
      * @brief Write some plaintext bytes (encrypted on the wire).
+     *
+     * One backend write; bytes may be less than size. Use write_all() to
+     * send everything.
+     */
+    TlsIoResult write_some(const void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Scatter read of decrypted bytes into buffers, in order.
+     */
+    TlsIoResult read_some(std::span<const MutableBuffer> buffers, Deadline deadline = {});
+
+    /**
+     * @brief Gather write: buffers are encrypted as one plaintext sequence.
+     */
+    TlsIoResult write_some(std::span<const ConstBuffer> buffers, Deadline deadline = {});
+
+    /**
+     * @brief Write all plaintext bytes, looping over write_some().
+     *
+     * The deadline covers the entire transfer. On failure bytes reports
+     * how much was sent before the error.
+     */
+    TlsIoResult write_all(const void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Gather form of write_all().
+     */
+    TlsIoResult write_all(std::span<const ConstBuffer> buffers, Deadline deadline = {});
+
+    /**
+     * @brief Read exactly size decrypted bytes.
+     *
+     * Reports connection_closed if the peer closes first.
      */
-    TlsIoResult write_some(const void *data, std::size_t size);
+    TlsIoResult read_exact(void *data, std::size_t size, Deadline deadline = {});
 
     /**
      * @brief TLS shutdown (close_notify when supported).
      */
     Error shutdown();
 
+    /**
+     * @brief Awaitable form of handshake().
+     */
+    Task<Error> async_handshake(Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of read_some().
+     */
+    Task<TlsIoResult> async_read_some(void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of write_some().
+     */
+    Task<TlsIoResult> async_write_some(const void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable scatter read.
+     */
+    Task<TlsIoResult> async_read_some(std::span<const MutableBuffer> buffers, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable gather write.
+     */
+    Task<TlsIoResult> async_write_some(std::span<const ConstBuffer> buffers, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of write_all().
+     */
+    Task<TlsIoResult> async_write_all(const void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable gather form of write_all().
+     */
+    Task<TlsIoResult> async_write_all(std::span<const ConstBuffer> buffers, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of read_exact().
+     */
+    Task<TlsIoResult> async_read_exact(void *data, std::size_t size, Deadline deadline = {});
+
+    /**
+     * @brief Awaitable form of shutdown().
+     */
+    Task<Error> async_shutdown();
+
     /**
      * @brief Close underlying TCP socket (best-effort).
+     *
+     * Sends close_notify first (blocking) while the socket is connected;
+     * close the Socket beforehand to skip it. The destructor calls this.
      */
     void close() noexcept;
 
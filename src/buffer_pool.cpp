@@ -0,0 +1,463 @@
+#include <vix/net_corosio/buffer_pool.hpp>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace vix::net_corosio
+{
+  namespace
+  {
+    constexpr std::size_t huge_page = 2 * 1024 * 1024;
+    constexpr std::align_val_t block_align{BufferPool::min_block};
+
+    struct FreeBlock
+    {
+      FreeBlock *next;
+    };
+
+    constexpr std::size_t class_of(std::size_t bytes) noexcept
+    {
+      if (bytes <= BufferPool::min_block)
+        return 0;
+
+      // 4097..8192 -> 1, 8193..16384 -> 2, ...
+      return static_cast<std::size_t>(std::bit_width(bytes - 1)) - 12;
+    }
+
+    constexpr std::size_t block_size(std::size_t cls) noexcept
+    {
+      return BufferPool::min_block << cls;
+    }
+
+    constexpr std::size_t round_up(std::size_t n, std::size_t unit) noexcept
+    {
+      return (n + unit - 1) / unit * unit;
+    }
+
+    char *heap_block(std::size_t bytes) noexcept
+    {
+      return static_cast<char *>(::operator new(bytes, block_align, std::nothrow));
+    }
+
+    void free_heap_block(char *p) noexcept
+    {
+      ::operator delete(static_cast<void *>(p), block_align);
+    }
+
+    /**
+     * @brief Pool state shared by the pool and the thread caches holding
+     * its blocks, so a cache never points at a destroyed pool.
+     */
+    struct PoolState : std::enable_shared_from_this<PoolState>
+    {
+      explicit PoolState(const BufferPoolOptions &o);
+      ~PoolState();
+
+      PoolState(const PoolState &) = delete;
+      PoolState &operator=(const PoolState &) = delete;
+
+      bool in_arena(const char *p) const noexcept
+      {
+        return arena && p >= arena && p < arena + arena_bytes;
+      }
+
+      char *take(std::size_t cls) noexcept;
+      void give(char *p, std::size_t cls) noexcept;
+
+      // Push onto the shared list. Caller holds mutex.
+      void push_locked(char *p, std::size_t cls) noexcept
+      {
+        auto *b = reinterpret_cast<FreeBlock *>(p);
+        b->next = free[cls];
+        free[cls] = b;
+      }
+
+      BufferPoolOptions options;
+
+      char *arena{nullptr};
+      std::size_t arena_bytes{0};
+      bool huge{false};
+
+      std::mutex mutex;
+      std::size_t arena_used{0};                  // guarded by mutex
+      std::array<FreeBlock *, BufferPool::classes> free{}; // guarded by mutex
+
+      std::atomic<std::size_t> in_use{0};
+      std::atomic<std::size_t> idle{0};
+    };
+
+    /**
+     * @brief Per-thread free lists for the pool this thread last released to.
+     *
+     * A thread normally serves one Context; when it releases into another
+     * pool, the cached blocks go back to their own pool first.
+     */
+    struct ThreadCache final
+    {
+      std::shared_ptr<PoolState> owner;
+      std::array<FreeBlock *, BufferPool::classes> heads{};
+      std::array<std::size_t, BufferPool::classes> counts{};
+
+      ThreadCache() noexcept;
+      ~ThreadCache();
+
+      void flush() noexcept;
+    };
+
+    // Cleared when the cache is destroyed at thread exit, so buffers
+    // released by later thread_local destructors bypass it.
+    thread_local bool tls_cache_alive = false;
+
+    ThreadCache::ThreadCache() noexcept
+    {
+      tls_cache_alive = true;
+    }
+
+    ThreadCache::~ThreadCache()
+    {
+      tls_cache_alive = false;
+      flush();
+    }
+
+    void ThreadCache::flush() noexcept
+    {
+      if (!owner)
+        return;
+
+      {
+        std::lock_guard<std::mutex> lock(owner->mutex);
+
+        for (std::size_t c = 0; c < BufferPool::classes; ++c)
+        {
+          while (FreeBlock *b = heads[c])
+          {
+            heads[c] = b->next;
+            owner->push_locked(reinterpret_cast<char *>(b), c);
+          }
+          counts[c] = 0;
+        }
+      }
+
+      owner.reset();
+    }
+
+    ThreadCache *this_thread_cache() noexcept
+    {
+      thread_local ThreadCache cache;
+      return tls_cache_alive ? &cache : nullptr;
+    }
+
+    PoolState::PoolState(const BufferPoolOptions &o)
+        : options(o)
+    {
+#if defined(__linux__)
+      if (options.arena_bytes == 0)
+        return;
+
+      void *p = MAP_FAILED;
+
+#if defined(MAP_HUGETLB)
+      if (options.huge_pages)
+      {
+        const std::size_t bytes = round_up(options.arena_bytes, huge_page);
+        p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED)
+        {
+          arena_bytes = bytes;
+          huge = true;
+        }
+      }
+#endif
+
+      if (p == MAP_FAILED)
+      {
+        const long page = ::sysconf(_SC_PAGESIZE);
+        const std::size_t unit = page > 0 ? static_cast<std::size_t>(page) : 4096;
+        const std::size_t bytes = round_up(options.arena_bytes, unit);
+
+        p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+          return;
+
+        arena_bytes = bytes;
+
+#if defined(MADV_HUGEPAGE)
+        if (options.huge_pages)
+          (void)::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+      }
+
+      arena = static_cast<char *>(p);
+#endif
+    }
+
+    PoolState::~PoolState()
+    {
+      for (std::size_t c = 0; c < BufferPool::classes; ++c)
+      {
+        while (FreeBlock *b = free[c])
+        {
+          free[c] = b->next;
+          auto *p = reinterpret_cast<char *>(b);
+          if (!in_arena(p))
+            free_heap_block(p);
+        }
+      }
+
+#if defined(__linux__)
+      if (arena)
+        (void)::munmap(arena, arena_bytes);
+#endif
+    }
+
+    char *PoolState::take(std::size_t cls) noexcept
+    {
+      const std::size_t size = block_size(cls);
+
+      ThreadCache *cache = this_thread_cache();
+      if (cache && cache->owner.get() == this)
+      {
+        if (FreeBlock *b = cache->heads[cls])
+        {
+          cache->heads[cls] = b->next;
+          --cache->counts[cls];
+          idle.fetch_sub(size, std::memory_order_relaxed);
+          return reinterpret_cast<char *>(b);
+        }
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (FreeBlock *b = free[cls])
+        {
+          free[cls] = b->next;
+          idle.fetch_sub(size, std::memory_order_relaxed);
+          return reinterpret_cast<char *>(b);
+        }
+
+        // Arena offsets stay multiples of min_block, so blocks are aligned.
+        if (arena && arena_bytes - arena_used >= size)
+        {
+          char *p = arena + arena_used;
+          arena_used += size;
+          return p;
+        }
+      }
+
+      return heap_block(size);
+    }
+
+    void PoolState::give(char *p, std::size_t cls) noexcept
+    {
+      idle.fetch_add(block_size(cls), std::memory_order_relaxed);
+
+      if (ThreadCache *cache = this_thread_cache())
+      {
+        if (cache->owner.get() != this)
+        {
+          cache->flush();
+          cache->owner = shared_from_this();
+        }
+
+        if (cache->counts[cls] < options.thread_cache_blocks)
+        {
+          auto *b = reinterpret_cast<FreeBlock *>(p);
+          b->next = cache->heads[cls];
+          cache->heads[cls] = b;
+          ++cache->counts[cls];
+          return;
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      push_locked(p, cls);
+    }
+  } // namespace
+
+  struct BufferPool::Impl final : PoolState
+  {
+    using PoolState::PoolState;
+
+    void release(char *p, std::size_t capacity) noexcept
+    {
+      in_use.fetch_sub(capacity, std::memory_order_relaxed);
+
+      if (capacity > BufferPool::max_block)
+        free_heap_block(p);
+      else
+        give(p, class_of(capacity));
+    }
+  };
+
+  BufferPool::BufferPool(BufferPoolOptions options)
+      : impl_(std::make_shared<Impl>(options))
+  {
+  }
+
+  BufferPool::BufferPool(BufferPool &&) noexcept = default;
+  BufferPool &BufferPool::operator=(BufferPool &&other) noexcept
+  {
+    if (this != &other)
+    {
+      // Let go of this thread's cached blocks before the state may go away.
+      ThreadCache *cache = impl_ ? this_thread_cache() : nullptr;
+      if (cache && cache->owner.get() == impl_.get())
+        cache->flush();
+
+      impl_ = std::move(other.impl_);
+    }
+    return *this;
+  }
+
+  BufferPool::~BufferPool()
+  {
+    // Other threads' caches keep the state alive until they exit or
+    // release into another pool; this thread's can go now.
+    ThreadCache *cache = impl_ ? this_thread_cache() : nullptr;
+    if (cache && cache->owner.get() == impl_.get())
+      cache->flush();
+  }
+
+  PooledBuffer BufferPool::acquire(std::size_t bytes)
+  {
+    if (!impl_)
+      return PooledBuffer{};
+
+    const std::size_t size = bytes == 0 ? min_block : bytes;
+
+    if (size > max_block)
+    {
+      const std::size_t capacity = round_up(size, min_block);
+      char *p = heap_block(capacity);
+      if (!p)
+        return PooledBuffer{};
+
+      impl_->in_use.fetch_add(capacity, std::memory_order_relaxed);
+      return PooledBuffer(impl_.get(), p, size, capacity);
+    }
+
+    const std::size_t cls = class_of(size);
+    char *p = impl_->take(cls);
+    if (!p)
+      return PooledBuffer{};
+
+    impl_->in_use.fetch_add(block_size(cls), std::memory_order_relaxed);
+    return PooledBuffer(impl_.get(), p, size, block_size(cls));
+  }
+
+  std::size_t BufferPool::trim() noexcept
+  {
+    if (!impl_)
+      return 0;
+
+    std::size_t released = 0;
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+
+    for (std::size_t c = 0; c < classes; ++c)
+    {
+      const std::size_t size = block_size(c);
+
+      FreeBlock *keep = nullptr;
+      while (FreeBlock *b = impl_->free[c])
+      {
+        impl_->free[c] = b->next;
+        auto *p = reinterpret_cast<char *>(b);
+
+        if (!impl_->in_arena(p))
+        {
+          free_heap_block(p);
+          impl_->idle.fetch_sub(size, std::memory_order_relaxed);
+          released += size;
+          continue;
+        }
+
+#if defined(__linux__)
+        // Drop the pages but keep the first one's link word: the block
+        // stays on the list. Huge pages cannot be partially dropped.
+        if (!impl_->huge && size > min_block)
+        {
+          if (::madvise(p + min_block, size - min_block, MADV_DONTNEED) == 0)
+            released += size - min_block;
+        }
+#endif
+
+        b->next = keep;
+        keep = b;
+      }
+
+      impl_->free[c] = keep;
+    }
+
+    return released;
+  }
+
+  bool BufferPool::huge_pages() const noexcept
+  {
+    return impl_ && impl_->huge;
+  }
+
+  BufferPoolStats BufferPool::stats() const noexcept
+  {
+    BufferPoolStats out{};
+    if (!impl_)
+      return out;
+
+    out.in_use_bytes = impl_->in_use.load(std::memory_order_relaxed);
+    out.idle_bytes = impl_->idle.load(std::memory_order_relaxed);
+    out.arena_bytes = impl_->arena_bytes;
+
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    out.arena_used_bytes = impl_->arena_used;
+    return out;
+  }
+
+  PooledBuffer::PooledBuffer(PooledBuffer &&other) noexcept
+      : owner_(std::exchange(other.owner_, nullptr)),
+        data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0))
+  {
+  }
+
+  PooledBuffer &PooledBuffer::operator=(PooledBuffer &&other) noexcept
+  {
+    if (this != &other)
+    {
+      reset();
+      owner_ = std::exchange(other.owner_, nullptr);
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+    }
+    return *this;
+  }
+
+  PooledBuffer::~PooledBuffer()
+  {
+    reset();
+  }
+
+  void PooledBuffer::reset() noexcept
+  {
+    if (owner_ && data_)
+      owner_->release(data_, capacity_);
+
+    owner_ = nullptr;
+    data_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+  }
+
+} // namespace vix::net_corosio
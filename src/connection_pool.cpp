@@ -0,0 +1,699 @@
+#include <vix/net_corosio/connection_pool.hpp>
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/timer.hpp>
+
+#include <boost/corosio.hpp>
+
+#include "detail/composed.hpp"
+#include "detail/frame_pool.hpp"
+#include "detail/native.hpp"
+#include "detail/run_blocking.hpp"
+#include "detail/waiter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <compare>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+
+namespace vix::net_corosio
+{
+  namespace
+  {
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Connections are interchangeable only within one key.
+     */
+    struct PoolKey final
+    {
+      std::string host;
+      std::string service;
+      const TlsContext *tls{nullptr};
+      std::string sni;
+      std::vector<std::string> alpn;
+
+      auto operator<=>(const PoolKey &) const = default;
+    };
+
+    PoolKey make_key(const PoolTarget &target)
+    {
+      PoolKey key{target.host, target.service, target.tls, {}, {}};
+
+      if (target.tls)
+      {
+        key.sni = std::string(target.tls->hostname());
+        key.alpn.assign(target.tls->alpn().begin(), target.tls->alpn().end());
+      }
+
+      return key;
+    }
+
+    /**
+     * @brief Close a pooled connection without a TLS shutdown.
+     *
+     * ~TlsStream sends close_notify through the blocking wrapper, which
+     * would stall the loop thread that evicts or discards the connection.
+     * With the socket closed first it only releases its state.
+     */
+    void close_plain(std::unique_ptr<Socket> &sock, std::unique_ptr<TlsStream> &tls) noexcept
+    {
+      if (sock)
+        sock->close();
+
+      tls.reset();
+      sock.reset();
+    }
+
+    struct IdleConnection final
+    {
+      std::unique_ptr<Socket> sock;
+      std::unique_ptr<TlsStream> tls;
+      clock::time_point since{};
+
+      IdleConnection(std::unique_ptr<Socket> s, std::unique_ptr<TlsStream> t, clock::time_point at) noexcept
+          : sock(std::move(s)), tls(std::move(t)), since(at)
+      {
+      }
+
+      IdleConnection(IdleConnection &&) noexcept = default;
+
+      IdleConnection &operator=(IdleConnection &&other) noexcept
+      {
+        if (this != &other)
+        {
+          close_plain(sock, tls);
+          sock = std::move(other.sock);
+          tls = std::move(other.tls);
+          since = other.since;
+        }
+        return *this;
+      }
+
+      ~IdleConnection() { close_plain(sock, tls); }
+    };
+
+    /**
+     * @brief A checkout parked until its target has room.
+     *
+     * Fields other than wake are guarded by PoolState::mu.
+     */
+    struct SlotWaiter final
+    {
+      detail::Waiter wake{};
+      bool woken{false}; // picked by a release; retry the checkout
+      bool done{false};  // the checkout stopped waiting
+      Timer *expiry{nullptr};
+    };
+
+    struct HostSlots final
+    {
+      std::vector<IdleConnection> idle; // most recently released last
+      std::size_t in_use{0};
+      std::deque<std::shared_ptr<SlotWaiter>> waiters; // oldest first
+    };
+
+    /**
+     * @brief Bookkeeping shared by the pool and its checked-out connections.
+     */
+    struct PoolState final
+    {
+      Context *ctx{nullptr};
+      PoolOptions options;
+      std::mutex mu{};
+      std::map<PoolKey, HostSlots> hosts{}; // entries are never erased
+      bool closed{false};
+
+      // Caller holds mu. A connection or slot was freed: pick the oldest
+      // parked checkout, to be woken with notify() after unlocking.
+      std::shared_ptr<SlotWaiter> next_waiter(HostSlots &host) noexcept
+      {
+        while (!host.waiters.empty())
+        {
+          std::shared_ptr<SlotWaiter> w = std::move(host.waiters.front());
+          host.waiters.pop_front();
+
+          if (!w->done)
+          {
+            w->woken = true;
+            return w;
+          }
+        }
+        return {};
+      }
+
+      // Resume on the loop, not inline: release() may run on any thread.
+      void notify(std::shared_ptr<SlotWaiter> w) noexcept
+      {
+        if (!w)
+          return;
+
+        try
+        {
+          ctx->get_executor().post([w]
+                                   { w->wake.wake(); });
+        }
+        catch (...)
+        {
+          w->wake.wake();
+        }
+      }
+
+      // Caller holds mu. Expired connections go to out, closed after unlocking.
+      void evict_expired(HostSlots &host, clock::time_point now, std::vector<IdleConnection> &out)
+      {
+        if (options.idle_timeout.count() <= 0)
+          return;
+
+        auto &idle = host.idle;
+        for (std::size_t i = 0; i < idle.size();)
+        {
+          if (now - idle[i].since >= options.idle_timeout)
+          {
+            out.push_back(std::move(idle[i]));
+            idle.erase(idle.begin() + static_cast<std::ptrdiff_t>(i));
+          }
+          else
+          {
+            ++i;
+          }
+        }
+      }
+    };
+
+    /**
+     * @brief Liveness check before reuse. Never blocks.
+     *
+     * Pending bytes on a plain connection are a stale or unsolicited reply.
+     * On TLS they may be a session ticket, but also a close_notify or an
+     * alert; TLS 1.3 encrypts the record type, so the two cannot be told
+     * apart without decrypting. Such a connection is dropped as well.
+     */
+    bool healthy(IdleConnection &c) noexcept
+    {
+      if (!c.sock || c.sock->state() != SocketState::connected)
+        return false;
+
+      auto *io = static_cast<corosio::tcp_socket *>(c.sock->native_handle());
+      const int fd = io ? detail::native_fd(*io) : -1;
+
+      // No probe on this platform.
+      if (fd < 0)
+        return true;
+
+      return detail::try_peek(fd).would_block;
+    }
+
+    /**
+     * @brief Wake w at its checkout's deadline.
+     *
+     * The checkout cancels the timer once it stops waiting.
+     */
+    capy::task<void> expire_waiter(std::shared_ptr<PoolState> pool, std::shared_ptr<SlotWaiter> w,
+                                   Timer::time_point at)
+    {
+      Timer t(*pool->ctx);
+      t.expires_at(at);
+
+      bool armed = false;
+      {
+        std::lock_guard<std::mutex> lock(pool->mu);
+        if (!w->done)
+        {
+          w->expiry = &t;
+          armed = true;
+        }
+      }
+
+      if (armed)
+      {
+        try
+        {
+          (void)co_await t.async_wait();
+        }
+        catch (...)
+        {
+        }
+
+        std::lock_guard<std::mutex> lock(pool->mu);
+        w->expiry = nullptr;
+      }
+
+      w->wake.wake();
+    }
+  } // namespace
+
+  struct PooledConnection::Impl final
+  {
+    std::shared_ptr<PoolState> pool;
+    HostSlots *host{nullptr};
+    std::unique_ptr<Socket> sock;
+    std::unique_ptr<TlsStream> tls;
+    bool reused{false};
+
+    ~Impl() { close_plain(sock, tls); }
+  };
+
+  struct ConnectionPool::Impl final
+  {
+    Context *ctx{nullptr};
+    std::shared_ptr<PoolState> state;
+
+    Impl(Context &c, PoolOptions options)
+        : ctx(&c),
+          state(std::make_shared<PoolState>())
+    {
+      state->ctx = &c;
+      state->options = options;
+    }
+
+    // No more reuse; parked checkouts fail with invalid_state.
+    void close() noexcept
+    {
+      std::vector<std::shared_ptr<SlotWaiter>> parked;
+
+      {
+        std::lock_guard<std::mutex> lock(state->mu);
+        state->closed = true;
+
+        for (auto &[key, host] : state->hosts)
+        {
+          while (auto w = state->next_waiter(host))
+          {
+            try
+            {
+              parked.push_back(std::move(w));
+            }
+            catch (...)
+            {
+              w->wake.wake();
+            }
+          }
+        }
+      }
+
+      for (auto &w : parked)
+        state->notify(std::move(w));
+    }
+  };
+
+  PooledConnection::PooledConnection(PooledConnection &&other) noexcept
+      : impl_(other.impl_)
+  {
+    other.impl_ = nullptr;
+  }
+
+  PooledConnection &PooledConnection::operator=(PooledConnection &&other) noexcept
+  {
+    if (this != &other)
+    {
+      discard();
+      impl_ = other.impl_;
+      other.impl_ = nullptr;
+    }
+    return *this;
+  }
+
+  PooledConnection::~PooledConnection()
+  {
+    discard();
+  }
+
+  PooledConnection::operator bool() const noexcept
+  {
+    return impl_ != nullptr;
+  }
+
+  Socket &PooledConnection::socket() noexcept
+  {
+    return *impl_->sock;
+  }
+
+  TlsStream *PooledConnection::tls() noexcept
+  {
+    return impl_ ? impl_->tls.get() : nullptr;
+  }
+
+  bool PooledConnection::reused() const noexcept
+  {
+    return impl_ && impl_->reused;
+  }
+
+  void PooledConnection::release() noexcept
+  {
+    if (!impl_)
+      return;
+
+    Impl *c = std::exchange(impl_, nullptr);
+    PoolState &pool = *c->pool;
+
+    std::vector<IdleConnection> dropped;
+    std::shared_ptr<SlotWaiter> next;
+
+    {
+      std::lock_guard<std::mutex> lock(pool.mu);
+      --c->host->in_use;
+
+      try
+      {
+        const auto now = clock::now();
+        const bool keep = c->sock && c->sock->state() == SocketState::connected;
+
+        if (keep && !pool.closed)
+          c->host->idle.emplace_back(std::move(c->sock), std::move(c->tls), now);
+
+        pool.evict_expired(*c->host, now, dropped);
+      }
+      catch (...)
+      {
+        // Out of memory: the connection is closed below instead.
+      }
+
+      next = pool.next_waiter(*c->host);
+    }
+
+    pool.notify(std::move(next));
+    delete c;
+  }
+
+  void PooledConnection::discard() noexcept
+  {
+    if (!impl_)
+      return;
+
+    Impl *c = std::exchange(impl_, nullptr);
+    std::shared_ptr<SlotWaiter> next;
+
+    {
+      std::lock_guard<std::mutex> lock(c->pool->mu);
+      --c->host->in_use;
+      next = c->pool->next_waiter(*c->host);
+    }
+
+    c->pool->notify(std::move(next));
+    delete c;
+  }
+
+  ConnectionPool::ConnectionPool(Context &ctx, PoolOptions options)
+      : impl_(new Impl(ctx, options))
+  {
+  }
+
+  ConnectionPool::ConnectionPool(ConnectionPool &&other) noexcept
+      : impl_(other.impl_)
+  {
+    other.impl_ = nullptr;
+  }
+
+  ConnectionPool &ConnectionPool::operator=(ConnectionPool &&other) noexcept
+  {
+    if (this != &other)
+    {
+      if (impl_)
+        impl_->close();
+
+      clear();
+      delete impl_;
+      impl_ = other.impl_;
+      other.impl_ = nullptr;
+    }
+    return *this;
+  }
+
+  ConnectionPool::~ConnectionPool()
+  {
+    if (impl_)
+    {
+      impl_->close();
+      clear();
+      delete impl_;
+      impl_ = nullptr;
+    }
+  }
+
+  CheckoutResult ConnectionPool::checkout(const PoolTarget &target, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ctx)
+      return CheckoutResult{Error{ErrorCode::not_initialized}, {}};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_checkout(target, deadline); });
+  }
+
+  Task<CheckoutResult> ConnectionPool::async_checkout(PoolTarget target, Deadline deadline)
+  {
+    CheckoutResult out{};
+    out.error = Error{ErrorCode::unknown};
+
+    if (!impl_ || !impl_->ctx)
+    {
+      out.error = Error{ErrorCode::not_initialized};
+      co_return out;
+    }
+
+    if (target.host.empty() || target.service.empty() ||
+        (target.tls && target.tls->role() != TlsRole::client))
+    {
+      out.error = Error{ErrorCode::invalid_argument};
+      co_return out;
+    }
+
+    Context &ctx = *impl_->ctx;
+    const std::shared_ptr<PoolState> state = impl_->state;
+    const Deadline d = detail::composed_deadline(deadline, ctx.config().io_timeout);
+
+    HostSlots *host = nullptr;
+
+    // Take an idle connection or a free slot; park while the target is full.
+    for (;;)
+    {
+      std::vector<IdleConnection> dropped;
+      std::optional<IdleConnection> reuse;
+      std::shared_ptr<SlotWaiter> waiter;
+      bool dial = false;
+
+      try
+      {
+        const PoolKey key = make_key(target);
+
+        std::lock_guard<std::mutex> lock(state->mu);
+        if (state->closed)
+        {
+          out.error = Error{ErrorCode::invalid_state};
+          co_return out;
+        }
+
+        host = &state->hosts[key];
+
+        state->evict_expired(*host, clock::now(), dropped);
+
+        while (!host->idle.empty())
+        {
+          IdleConnection c = std::move(host->idle.back());
+          host->idle.pop_back();
+
+          if (healthy(c))
+          {
+            reuse.emplace(std::move(c));
+            break;
+          }
+
+          dropped.push_back(std::move(c));
+        }
+
+        const std::size_t max = state->options.max_per_host;
+        if (reuse || max == 0 || host->in_use < max)
+        {
+          ++host->in_use;
+          dial = !reuse;
+        }
+        else if (d.is_never() || Deadline::clock::now() < d.time())
+        {
+          waiter = std::make_shared<SlotWaiter>();
+          host->waiters.push_back(waiter);
+        }
+      }
+      catch (...)
+      {
+        co_return out;
+      }
+
+      if (reuse)
+      {
+        out.connection.impl_ = new PooledConnection::Impl{
+            state, host, std::move(reuse->sock), std::move(reuse->tls), true};
+        out.error = Error{ErrorCode::none};
+        co_return out;
+      }
+
+      if (dial)
+        break;
+
+      if (!waiter)
+      {
+        out.error = Error{ErrorCode::timeout};
+        co_return out;
+      }
+
+      // Woken by release()/discard() or by the deadline; both retry.
+      if (!d.is_never())
+      {
+        try
+        {
+          auto &ioc = *static_cast<corosio::io_context *>(ctx.native_handle());
+          detail::launcher(ioc.get_executor())(expire_waiter(state, waiter, d.time()));
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock(state->mu);
+          waiter->done = true;
+          std::erase(host->waiters, waiter);
+          co_return out;
+        }
+      }
+
+      co_await waiter->wake.wait();
+
+      {
+        std::lock_guard<std::mutex> lock(state->mu);
+        waiter->done = true;
+
+        if (waiter->expiry)
+          waiter->expiry->cancel();
+
+        if (!waiter->woken)
+          std::erase(host->waiters, waiter);
+      }
+    }
+
+    auto give_back = [&]
+    {
+      std::shared_ptr<SlotWaiter> next;
+      {
+        std::lock_guard<std::mutex> lock(state->mu);
+        --host->in_use;
+        next = state->next_waiter(*host);
+      }
+      state->notify(std::move(next));
+    };
+
+    std::unique_ptr<Socket> sock;
+    std::unique_ptr<TlsStream> tls;
+
+    try
+    {
+      sock = std::make_unique<Socket>(ctx);
+    }
+    catch (...)
+    {
+      give_back();
+      co_return out;
+    }
+
+    Error e = co_await sock->async_connect(target.host, target.service, d);
+
+    if (!e && target.tls)
+    {
+      try
+      {
+        tls = std::make_unique<TlsStream>(*sock, *target.tls);
+        e = co_await tls->async_handshake(d);
+      }
+      catch (...)
+      {
+        e = Error{ErrorCode::unknown};
+      }
+    }
+
+    if (e)
+    {
+      close_plain(sock, tls);
+      give_back();
+      out.error = e;
+      co_return out;
+    }
+
+    out.connection.impl_ = new PooledConnection::Impl{
+        state, host, std::move(sock), std::move(tls), false};
+    out.error = Error{ErrorCode::none};
+    co_return out;
+  }
+
+  std::size_t ConnectionPool::evict_idle()
+  {
+    if (!impl_)
+      return 0;
+
+    std::vector<IdleConnection> dropped;
+
+    try
+    {
+      const auto now = clock::now();
+
+      std::lock_guard<std::mutex> lock(impl_->state->mu);
+      for (auto &[key, host] : impl_->state->hosts)
+        impl_->state->evict_expired(host, now, dropped);
+    }
+    catch (...)
+    {
+    }
+
+    return dropped.size();
+  }
+
+  void ConnectionPool::clear() noexcept
+  {
+    if (!impl_)
+      return;
+
+    std::vector<std::vector<IdleConnection>> dropped;
+
+    try
+    {
+      std::lock_guard<std::mutex> lock(impl_->state->mu);
+      for (auto &[key, host] : impl_->state->hosts)
+        dropped.emplace_back().swap(host.idle);
+    }
+    catch (...)
+    {
+    }
+  }
+
+  std::size_t ConnectionPool::idle_count() const noexcept
+  {
+    if (!impl_)
+      return 0;
+
+    std::lock_guard<std::mutex> lock(impl_->state->mu);
+
+    std::size_t n = 0;
+    for (const auto &[key, host] : impl_->state->hosts)
+      n += host.idle.size();
+    return n;
+  }
+
+  std::size_t ConnectionPool::in_use_count() const noexcept
+  {
+    if (!impl_)
+      return 0;
+
+    std::lock_guard<std::mutex> lock(impl_->state->mu);
+
+    std::size_t n = 0;
+    for (const auto &[key, host] : impl_->state->hosts)
+      n += host.in_use;
+    return n;
+  }
+
+} // namespace vix::net_corosio
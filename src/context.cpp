@@ -2,11 +2,21 @@
 
 #include <boost/corosio.hpp>
 
+#include "detail/context_access.hpp"
+#include "detail/frame_pool.hpp"
+#include "detail/readiness.hpp"
+#include "detail/scheduler.hpp"
+#include "detail/timer_service.hpp"
+
 #include <atomic>
+#include <cstddef>
 #include <exception>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace corosio = boost::corosio;
+namespace capy = boost::capy;
 
 namespace vix::net_corosio
 {
@@ -28,13 +38,58 @@ namespace vix::net_corosio
     Config cfg{};
     corosio::io_context ioc{};
     std::atomic<bool> stop_requested{false};
+    std::atomic<std::size_t> runners{0};
+    detail::Scheduler sched;
+    detail::TimerService timers;
+    detail::ReadinessService readiness;
+    BufferPool buffers;
 
     explicit Impl(Config c)
-        : cfg(std::move(c)), ioc()
+        : cfg(std::move(c)), ioc(), sched(ioc), timers(ioc), readiness(timers), buffers(cfg.buffer_pool)
     {
     }
   };
 
+  detail::TimerService &detail::ContextAccess::timers(Context &ctx) noexcept
+  {
+    return ctx.impl_->timers;
+  }
+
+  detail::ReadinessService &detail::ContextAccess::readiness(Context &ctx) noexcept
+  {
+    return ctx.impl_->readiness;
+  }
+
+  namespace
+  {
+    /**
+     * @brief Marks the current thread as running a context for its lifetime.
+     */
+    class RunScope final
+    {
+    public:
+      explicit RunScope(std::atomic<std::size_t> &runners, const detail::Scheduler &sched) noexcept
+          : runners_(runners), prev_(detail::current_scheduler())
+      {
+        runners_.fetch_add(1, std::memory_order_acq_rel);
+        detail::current_scheduler() = &sched;
+      }
+
+      RunScope(const RunScope &) = delete;
+      RunScope &operator=(const RunScope &) = delete;
+
+      ~RunScope()
+      {
+        detail::current_scheduler() = prev_;
+        runners_.fetch_sub(1, std::memory_order_acq_rel);
+      }
+
+    private:
+      std::atomic<std::size_t> &runners_;
+      const detail::Scheduler *prev_{nullptr};
+    };
+  } // namespace
+
   Context::Context()
       : impl_(std::make_unique<Impl>(default_config()))
   {
@@ -72,7 +127,48 @@ namespace vix::net_corosio
 
       impl_->stop_requested.store(false, std::memory_order_relaxed);
 
-      impl_->ioc.run();
+      Impl *impl = impl_.get();
+      const std::size_t threads = impl->cfg.io_threads > 1 ? impl->cfg.io_threads : 1;
+
+      std::atomic<bool> failed{false};
+
+      {
+        // jthread joins on scope exit, including when run() below throws.
+        std::vector<std::jthread> extra;
+        extra.reserve(threads - 1);
+
+        for (std::size_t i = 1; i < threads; ++i)
+        {
+          extra.emplace_back([impl, &failed]
+                             {
+                               try
+                               {
+                                 RunScope scope(impl->runners, impl->sched);
+                                 impl->ioc.run();
+                               }
+                               catch (...)
+                               {
+                                 failed.store(true, std::memory_order_relaxed);
+                                 impl->ioc.stop();
+                               } });
+        }
+
+        try
+        {
+          RunScope scope(impl->runners, impl->sched);
+          impl->ioc.run();
+        }
+        catch (...)
+        {
+          // Release the internal threads so they can be joined.
+          failed.store(true, std::memory_order_relaxed);
+          impl->ioc.stop();
+        }
+      }
+
+      if (failed.load(std::memory_order_relaxed))
+        return Error{ErrorCode::unknown};
+
       return Error{ErrorCode::none};
     }
     catch (...)
@@ -110,6 +206,46 @@ namespace vix::net_corosio
     return impl_->stop_requested.load(std::memory_order_relaxed);
   }
 
+  bool Context::running() const noexcept
+  {
+    return impl_ && impl_->runners.load(std::memory_order_acquire) != 0;
+  }
+
+  bool Context::running_in_this_thread() const noexcept
+  {
+    return impl_ && impl_->sched.running_in_this_thread();
+  }
+
+  void Context::spawn(Task<> task)
+  {
+    if (!impl_)
+      return;
+
+    detail::launcher(impl_->ioc.get_executor())(std::move(task));
+  }
+
+  void Context::spawn_from(Task<> (*make)(void *), void *state)
+  {
+    if (!impl_)
+      return;
+
+    // As in run_blocking(): make() runs once the launcher has installed
+    // the frame pool, so the task frame is drawn from it.
+    detail::launcher(impl_->ioc.get_executor())(make(state));
+  }
+
+  std::pmr::memory_resource *Context::frame_resource() noexcept
+  {
+    return &detail::frame_pool();
+  }
+
+  BufferPool &Context::buffer_pool() noexcept
+  {
+    // A moved-from Context still hands out working buffers.
+    static BufferPool fallback;
+    return impl_ ? impl_->buffers : fallback;
+  }
+
   void *Context::native_handle() noexcept
   {
     // Safe for moved-from Context.
@@ -125,10 +261,10 @@ namespace vix::net_corosio
   Executor Context::get_executor() noexcept
   {
     if (!impl_)
-      return Executor{nullptr};
+      return Executor{};
 
-    // store io_context handle, stable address
-    return Executor{static_cast<void *>(&(impl_->ioc))};
+    // store io_context handle and submission queue, both stable addresses
+    return Executor{static_cast<void *>(&(impl_->ioc)), static_cast<void *>(&(impl_->sched))};
   }
 
 } // namespace vix::net_corosio
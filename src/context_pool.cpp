@@ -0,0 +1,233 @@
+#include <vix/net_corosio/context_pool.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace vix::net_corosio
+{
+  struct ContextPool::Impl final
+  {
+    std::vector<std::unique_ptr<Context>> contexts{};
+    // Shared with the serve() frame of each shard, which may outlive run().
+    std::vector<std::shared_ptr<Listener>> listeners{};
+    std::atomic<std::size_t> next{0};
+    std::uint16_t port{0};
+    bool pin{false};
+  };
+
+  namespace
+  {
+    // Pool and index of the context the current thread runs, if any.
+    thread_local const void *tls_pool = nullptr;
+    thread_local std::size_t tls_index = 0;
+
+    void pin_to_cpu(std::size_t cpu) noexcept
+    {
+#if defined(__linux__)
+      const auto ncpu = std::thread::hardware_concurrency();
+      if (ncpu == 0)
+        return;
+
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(static_cast<int>(cpu % ncpu), &set);
+      (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+      (void)cpu;
+#endif
+    }
+
+    Error run_one_context(const void *pool, std::size_t index, Context &ctx, bool pin) noexcept
+    {
+      tls_pool = pool;
+      tls_index = index;
+
+      if (pin)
+        pin_to_cpu(index);
+
+      const Error e = ctx.run();
+
+      tls_pool = nullptr;
+      return e;
+    }
+  } // namespace
+
+  ContextPool::ContextPool(std::size_t size, Config cfg, bool pin_threads)
+      : impl_(std::make_unique<Impl>())
+  {
+    if (size == 0)
+      size = std::thread::hardware_concurrency();
+    if (size == 0)
+      size = 1;
+
+    // Shared-nothing: each context is driven by exactly one pool thread.
+    cfg.io_threads = 1;
+
+    impl_->pin = pin_threads;
+    impl_->contexts.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      impl_->contexts.push_back(std::make_unique<Context>(cfg));
+    }
+  }
+
+  ContextPool::ContextPool(ContextPool &&other) noexcept = default;
+
+  ContextPool &ContextPool::operator=(ContextPool &&other) noexcept = default;
+
+  ContextPool::~ContextPool() = default;
+
+  std::size_t ContextPool::size() const noexcept
+  {
+    return impl_ ? impl_->contexts.size() : 0;
+  }
+
+  Context &ContextPool::at(std::size_t i)
+  {
+    if (!impl_ || i >= impl_->contexts.size())
+      throw std::out_of_range("ContextPool::at");
+
+    return *impl_->contexts[i];
+  }
+
+  Context &ContextPool::next()
+  {
+    if (!impl_ || impl_->contexts.empty())
+      throw std::out_of_range("ContextPool::next");
+
+    const std::size_t i = impl_->next.fetch_add(1, std::memory_order_relaxed);
+    return *impl_->contexts[i % impl_->contexts.size()];
+  }
+
+  Context *ContextPool::this_thread_context() noexcept
+  {
+    if (!impl_ || tls_pool != impl_.get())
+      return nullptr;
+
+    return impl_->contexts[tls_index].get();
+  }
+
+  Error ContextPool::serve(std::uint16_t port, Listener::ConnectionHandler handler, int backlog)
+  {
+    if (!impl_)
+      return Error{ErrorCode::not_initialized};
+
+    if (!handler)
+      return Error{ErrorCode::invalid_argument};
+
+    std::vector<std::shared_ptr<Listener>> shards;
+    shards.reserve(impl_->contexts.size());
+
+    // Bind every shard before serving any, so a failure leaves nothing behind.
+    auto fail = [&shards](Error e)
+    {
+      for (auto &l : shards)
+      {
+        l->close();
+      }
+      return e;
+    };
+
+    for (auto &ctx : impl_->contexts)
+    {
+      shards.push_back(std::make_shared<Listener>(*ctx));
+      Listener &listener = *shards.back();
+
+      if (auto e = listener.open())
+        return fail(e);
+      if (auto e = listener.set_reuse_port(true))
+        return fail(e);
+      if (auto e = listener.bind(port))
+        return fail(e);
+      if (auto e = listener.listen(backlog))
+        return fail(e);
+
+      // Port 0: the first shard gets an ephemeral port, the rest share it.
+      if (port == 0)
+      {
+        port = listener.local_endpoint().port;
+        if (port == 0)
+          return fail(Error{ErrorCode::unknown});
+      }
+    }
+
+    for (std::size_t i = 0; i < shards.size(); ++i)
+    {
+      // The frame keeps its listener alive until serve() returns or the
+      // context destroys the frame, whichever comes first.
+      impl_->contexts[i]->spawn([](std::shared_ptr<Listener> l, Listener::ConnectionHandler h) -> Task<>
+                                { (void)co_await l->serve(std::move(h)); }(shards[i], handler));
+      impl_->listeners.push_back(std::move(shards[i]));
+    }
+
+    impl_->port = port;
+    return Error{ErrorCode::none};
+  }
+
+  std::uint16_t ContextPool::port() const noexcept
+  {
+    return impl_ ? impl_->port : 0;
+  }
+
+  Error ContextPool::run()
+  {
+    if (!impl_)
+      return Error{ErrorCode::invalid_state};
+
+    const std::size_t n = impl_->contexts.size();
+    std::vector<Error> results(n);
+
+    {
+      std::vector<std::jthread> threads;
+      threads.reserve(n - 1);
+
+      for (std::size_t i = 1; i < n; ++i)
+      {
+        threads.emplace_back([this, i, &results]
+                             { results[i] = run_one_context(impl_.get(), i, *impl_->contexts[i], impl_->pin); });
+      }
+
+      results[0] = run_one_context(impl_.get(), 0, *impl_->contexts[0], impl_->pin);
+    }
+
+    // A serve() frame still parked in accept holds its own reference, so
+    // closing only cancels the accept; the Listener goes with the frame.
+    for (auto &l : impl_->listeners)
+    {
+      l->close();
+    }
+    impl_->listeners.clear();
+
+    for (const Error &e : results)
+    {
+      if (e)
+        return e;
+    }
+
+    return Error{ErrorCode::none};
+  }
+
+  void ContextPool::stop() noexcept
+  {
+    if (!impl_)
+      return;
+
+    for (auto &ctx : impl_->contexts)
+    {
+      ctx->stop();
+    }
+  }
+
+} // namespace vix::net_corosio
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <vix/net_corosio/buffer.hpp>
+
+#include "native.hpp"
+
+#include <boost/capy/buffers.hpp>
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/uio.h>
+#endif
+
+namespace vix::net_corosio::detail
+{
+  namespace capy = boost::capy;
+
+  /**
+   * @brief Fixed-capacity array that spills to the heap for long sequences.
+   *
+   * Typical framed messages use a handful of buffers, so converting a
+   * caller's span (to iovecs or backend buffers) costs no allocation.
+   */
+  template <class T, std::size_t Inline = 16>
+  class SmallArray final
+  {
+  public:
+    explicit SmallArray(std::size_t n)
+        : size_(n)
+    {
+      if (n > Inline)
+      {
+        heap_.resize(n);
+        data_ = heap_.data();
+      }
+      else
+      {
+        data_ = inline_.data();
+      }
+    }
+
+    SmallArray(const SmallArray &) = delete;
+    SmallArray &operator=(const SmallArray &) = delete;
+
+    T *data() noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+
+    T &operator[](std::size_t i) noexcept { return data_[i]; }
+
+    std::span<const T> span() const noexcept { return {data_, size_}; }
+
+    void shrink(std::size_t n) noexcept
+    {
+      if (n < size_)
+        size_ = n;
+    }
+
+  private:
+    std::array<T, Inline> inline_{};
+    std::vector<T> heap_{};
+    T *data_{nullptr};
+    std::size_t size_{0};
+  };
+
+  inline const char *bytes_of(const ConstBuffer &b) noexcept
+  {
+    return static_cast<const char *>(b.data);
+  }
+
+  inline char *bytes_of(const MutableBuffer &b) noexcept
+  {
+    return static_cast<char *>(b.data);
+  }
+
+  /**
+   * @brief Backend buffer sequence for `buffers`, skipping the first `skip` bytes.
+   *
+   * Empty buffers are dropped.
+   */
+  template <class Backend, class Buffer>
+  void to_backend(std::span<const Buffer> buffers, std::size_t skip, SmallArray<Backend> &out) noexcept
+  {
+    std::size_t n = 0;
+
+    for (const auto &b : buffers)
+    {
+      if (skip >= b.size)
+      {
+        skip -= b.size;
+        continue;
+      }
+
+      out[n++] = Backend(bytes_of(b) + skip, b.size - skip);
+      skip = 0;
+    }
+
+    out.shrink(n);
+  }
+
+#if !defined(_WIN32)
+  /**
+   * @brief iovec array for readv()/writev()-style calls.
+   */
+  template <class Buffer>
+  void to_iovecs(std::span<const Buffer> buffers, SmallArray<::iovec> &out) noexcept
+  {
+    std::size_t n = 0;
+
+    for (const auto &b : buffers)
+    {
+      if (b.size == 0)
+        continue;
+
+      out[n].iov_base = const_cast<void *>(static_cast<const void *>(b.data));
+      out[n].iov_len = b.size;
+      ++n;
+    }
+
+    out.shrink(n);
+  }
+#endif
+
+  /**
+   * @brief Non-blocking readv()/writev() over a buffer sequence.
+   *
+   * Returns an empty NativeIo where the platform has no vectored path.
+   */
+  inline NativeIo try_readv(int fd, std::span<const MutableBuffer> buffers) noexcept
+  {
+#if defined(_WIN32)
+    (void)fd;
+    (void)buffers;
+    return NativeIo{};
+#else
+    SmallArray<::iovec> iov(buffers.size());
+    to_iovecs(buffers, iov);
+    return try_recvv(fd, iov.data(), iov.size());
+#endif
+  }
+
+  inline NativeIo try_writev(int fd, std::span<const ConstBuffer> buffers) noexcept
+  {
+#if defined(_WIN32)
+    (void)fd;
+    (void)buffers;
+    return NativeIo{};
+#else
+    SmallArray<::iovec> iov(buffers.size());
+    to_iovecs(buffers, iov);
+    return try_sendv(fd, iov.data(), iov.size());
+#endif
+  }
+
+} // namespace vix::net_corosio::detail
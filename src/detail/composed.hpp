@@ -0,0 +1,113 @@
+#pragma once
+
+#include <vix/net_corosio/buffer.hpp>
+#include <vix/net_corosio/deadline.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/task.hpp>
+
+#include "buffer_seq.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <span>
+
+namespace vix::net_corosio::detail
+{
+  /**
+   * @brief One absolute deadline for a whole composed operation.
+   *
+   * A default Deadline would otherwise restart the stream timeout on every
+   * partial transfer.
+   */
+  inline Deadline composed_deadline(const Deadline &d, std::chrono::milliseconds fallback) noexcept
+  {
+    if (!d.is_default())
+      return d;
+
+    if (fallback.count() <= 0)
+      return Deadline::never();
+
+    return Deadline::after(fallback);
+  }
+
+  /**
+   * @brief Loop async_write_some() until every byte is sent.
+   *
+   * On failure the result carries the error and the bytes sent so far.
+   */
+  template <class Result, class Stream>
+  Task<Result> write_all(Stream &s, const void *data, std::size_t size, Deadline deadline)
+  {
+    const auto *p = static_cast<const char *>(data);
+    std::size_t done = 0;
+
+    while (done < size)
+    {
+      auto r = co_await s.async_write_some(p + done, size - done, deadline);
+      if (!r.ok())
+      {
+        r.bytes = done;
+        co_return r;
+      }
+
+      done += r.bytes;
+    }
+
+    co_return Result{Error{ErrorCode::none}, done};
+  }
+
+  template <class Result, class Stream>
+  Task<Result> write_all(Stream &s, std::span<const ConstBuffer> buffers, Deadline deadline)
+  {
+    const std::size_t total = buffer_size(buffers);
+    std::size_t done = 0;
+
+    while (done < total)
+    {
+      SmallArray<ConstBuffer> rest(buffers.size());
+      to_backend(buffers, done, rest);
+
+      auto r = co_await s.async_write_some(rest.span(), deadline);
+      if (!r.ok())
+      {
+        r.bytes = done;
+        co_return r;
+      }
+
+      done += r.bytes;
+    }
+
+    co_return Result{Error{ErrorCode::none}, done};
+  }
+
+  /**
+   * @brief Loop async_read_some() until the buffer is full.
+   *
+   * End of stream before that reports connection_closed with the bytes
+   * read so far.
+   */
+  template <class Result, class Stream>
+  Task<Result> read_exact(Stream &s, void *data, std::size_t size, Deadline deadline)
+  {
+    auto *p = static_cast<char *>(data);
+    std::size_t done = 0;
+
+    while (done < size)
+    {
+      auto r = co_await s.async_read_some(p + done, size - done, deadline);
+      if (!r.ok())
+      {
+        r.bytes = done;
+        co_return r;
+      }
+
+      if (r.bytes == 0)
+        co_return Result{Error{ErrorCode::connection_closed}, done};
+
+      done += r.bytes;
+    }
+
+    co_return Result{Error{ErrorCode::none}, done};
+  }
+
+} // namespace vix::net_corosio::detail
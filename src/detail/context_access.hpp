@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vix/net_corosio/context.hpp>
+
+namespace vix::net_corosio::detail
+{
+  class ReadinessService;
+  class TimerService;
+
+  /**
+   * @brief Internal access to per-Context services.
+   *
+   * Keeps backend-facing services out of the public Context API; only
+   * translation units of this module include this header.
+   */
+  struct ContextAccess final
+  {
+    static TimerService &timers(Context &ctx) noexcept;
+    static ReadinessService &readiness(Context &ctx) noexcept;
+  };
+
+} // namespace vix::net_corosio::detail
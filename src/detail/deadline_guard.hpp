@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vix/net_corosio/deadline.hpp>
+
+#include "timer_service.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+namespace vix::net_corosio::detail
+{
+  /**
+   * @brief Absolute expiry of an operation, or nullopt for no limit.
+   */
+  inline std::optional<Deadline::clock::time_point>
+  effective_deadline(const Deadline &d, std::chrono::milliseconds fallback) noexcept
+  {
+    if (d.is_never())
+      return std::nullopt;
+
+    if (!d.is_default())
+      return d.time();
+
+    if (fallback.count() <= 0)
+      return std::nullopt;
+
+    return Deadline::clock::now() + fallback;
+  }
+
+  /**
+   * @brief Cancel pending operations on a backend I/O object.
+   *
+   * Falls back to close() on backends without cancel().
+   */
+  template <class Io>
+  void cancel_io(void *target) noexcept
+  {
+    auto &io = *static_cast<Io *>(target);
+
+    try
+    {
+      if constexpr (requires { io.cancel(); })
+        io.cancel();
+      else
+        io.close();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  /**
+   * @brief Per-operation deadline living in the operation's coroutine frame.
+   *
+   * Arms one timing-wheel node (no allocation); on expiry it records the
+   * timeout and cancels the backend operation from the loop thread.
+   * Disarming waits for an in-flight expiry, so the target is never
+   * touched after the guard is gone.
+   */
+  class DeadlineGuard final
+  {
+  public:
+    using cancel_fn = void (*)(void *target) noexcept;
+
+    DeadlineGuard() noexcept
+    {
+      node_.fire = &DeadlineGuard::on_fire;
+      node_.user = this;
+    }
+
+    DeadlineGuard(const DeadlineGuard &) = delete;
+    DeadlineGuard &operator=(const DeadlineGuard &) = delete;
+
+    ~DeadlineGuard() { disarm(); }
+
+    void arm(TimerService &svc, Deadline::clock::time_point at, cancel_fn fn, void *target)
+    {
+      fn_ = fn;
+      target_ = target;
+      svc_ = &svc;
+      svc.schedule(node_, at);
+    }
+
+    void disarm() noexcept
+    {
+      if (!svc_)
+        return;
+
+      if (!svc_->cancel(node_))
+      {
+        while (node_.state.load(std::memory_order_acquire) == TimerNode::firing)
+          std::this_thread::yield();
+      }
+
+      svc_ = nullptr;
+    }
+
+    bool expired() const noexcept
+    {
+      return expired_.load(std::memory_order_acquire);
+    }
+
+  private:
+    static void on_fire(TimerNode *n) noexcept
+    {
+      auto *self = static_cast<DeadlineGuard *>(n->user);
+      self->expired_.store(true, std::memory_order_release);
+      self->fn_(self->target_);
+    }
+
+    TimerNode node_{};
+    TimerService *svc_{nullptr};
+    cancel_fn fn_{nullptr};
+    void *target_{nullptr};
+    std::atomic<bool> expired_{false};
+  };
+
+} // namespace vix::net_corosio::detail
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <vix/net_corosio/socket.hpp>
+
+#include <boost/corosio.hpp>
+
+#include "native.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+namespace vix::net_corosio::detail
+{
+  namespace corosio = boost::corosio;
+
+  /**
+   * @brief Parse "localhost", an IPv4 literal or an IPv6 literal
+   * (optionally in brackets, as in "[::1]").
+   *
+   * An empty address means the IPv4 wildcard when allow_any is set.
+   */
+  inline bool parse_address(std::string_view address, std::uint16_t port, bool allow_any,
+                            corosio::endpoint &out)
+  {
+    if (address.empty())
+    {
+      if (!allow_any)
+        return false;
+
+      out = corosio::endpoint(corosio::ipv4_address::any(), port);
+      return true;
+    }
+
+    if (address == "localhost" || address == "127.0.0.1")
+    {
+      out = corosio::endpoint(corosio::ipv4_address::loopback(), port);
+      return true;
+    }
+
+    if (address.size() >= 2 && address.front() == '[' && address.back() == ']')
+      address = address.substr(1, address.size() - 2);
+
+    const std::string text(address);
+
+    if (text.find(':') == std::string::npos)
+    {
+      corosio::ipv4_address addr4;
+      if (corosio::parse_ipv4_address(text.c_str(), addr4))
+        return false;
+
+      out = corosio::endpoint(addr4, port);
+      return true;
+    }
+
+    corosio::ipv6_address addr6;
+    if (corosio::parse_ipv6_address(text.c_str(), addr6))
+      return false;
+
+    out = corosio::endpoint(addr6, port);
+    return true;
+  }
+
+  template <class F>
+  struct open_argument
+  {
+  };
+
+  template <class C, class R, class A>
+  struct open_argument<R (C::*)(A)>
+  {
+    using type = std::remove_cvref_t<A>;
+  };
+
+  template <class C, class R, class A>
+  struct open_argument<R (C::*)(A) noexcept>
+  {
+    using type = std::remove_cvref_t<A>;
+  };
+
+  template <class Io>
+  using open_protocol_t = typename open_argument<decltype(&Io::open)>::type;
+
+  // open(protocol) with protocol::v4()/v6(), as in Asio-style backends.
+  template <class Io>
+  concept has_family_open = requires {
+    typename open_protocol_t<Io>;
+    open_protocol_t<Io>::v4();
+    open_protocol_t<Io>::v6();
+  };
+
+  /**
+   * @brief Open a backend socket or acceptor for the endpoint's family.
+   *
+   * Backends whose open() takes no protocol only open IPv4 sockets; an
+   * IPv6 request reports not_supported instead of failing later in
+   * bind() or connect() with an unrelated error.
+   */
+  template <class Io>
+  Error open_for(Io &io, bool v6)
+  {
+    if constexpr (has_family_open<Io>)
+    {
+      using protocol = open_protocol_t<Io>;
+      io.open(v6 ? protocol::v6() : protocol::v4());
+    }
+    else
+    {
+      if (v6)
+        return Error{ErrorCode::not_supported};
+
+      io.open();
+    }
+
+    return Error{ErrorCode::none};
+  }
+
+  /**
+   * @brief Local (getsockname) or peer (getpeername) address of fd.
+   *
+   * Returns an empty endpoint when fd is not bound or on platforms
+   * without POSIX sockets.
+   */
+  inline TcpEndpoint endpoint_of(int fd, bool local)
+  {
+    TcpEndpoint out{};
+
+#if !defined(_WIN32)
+    if (fd < 0)
+      return out;
+
+    ::sockaddr_storage ss{};
+    ::socklen_t len = sizeof(ss);
+
+    const int rc = local ? ::getsockname(fd, reinterpret_cast<::sockaddr *>(&ss), &len)
+                         : ::getpeername(fd, reinterpret_cast<::sockaddr *>(&ss), &len);
+    if (rc != 0)
+      return out;
+
+    char text[INET6_ADDRSTRLEN]{};
+
+    if (ss.ss_family == AF_INET)
+    {
+      const auto *sin = reinterpret_cast<const ::sockaddr_in *>(&ss);
+      if (::inet_ntop(AF_INET, &sin->sin_addr, text, sizeof(text)))
+        out.address = text;
+      out.port = ntohs(sin->sin_port);
+    }
+    else if (ss.ss_family == AF_INET6)
+    {
+      const auto *sin6 = reinterpret_cast<const ::sockaddr_in6 *>(&ss);
+      if (::inet_ntop(AF_INET6, &sin6->sin6_addr, text, sizeof(text)))
+        out.address = text;
+      out.port = ntohs(sin6->sin6_port);
+    }
+#else
+    (void)fd;
+    (void)local;
+#endif
+
+    return out;
+  }
+
+  /**
+   * @brief IPV6_V6ONLY on an AF_INET6 socket.
+   */
+  inline Error set_v6_only(int fd, bool enabled) noexcept
+  {
+#if defined(IPV6_V6ONLY)
+    return set_int_option(fd, IPPROTO_IPV6, IPV6_V6ONLY, enabled ? 1 : 0);
+#else
+    (void)fd;
+    (void)enabled;
+    return Error{ErrorCode::not_supported};
+#endif
+  }
+
+} // namespace vix::net_corosio::detail
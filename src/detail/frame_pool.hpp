@@ -0,0 +1,67 @@
+#pragma once
+
+#include <boost/capy/ex/run_async.hpp>
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace vix::net_corosio::detail
+{
+  namespace capy = boost::capy;
+
+  /**
+   * @brief Recycling allocator for coroutine frames.
+   *
+   * Blocks are grouped in power-of-two size classes from 64 B to 4 KiB.
+   * Each thread keeps a bounded free list per class, so a frame released
+   * by an I/O operation is handed straight to the next one without touching
+   * the global heap. Larger or over-aligned requests go to operator new.
+   *
+   * Blocks may be freed on another thread than the one that allocated them;
+   * they then join that thread's cache.
+   */
+  class FramePool final : public std::pmr::memory_resource
+  {
+  public:
+    static constexpr std::size_t min_block = 64;
+    static constexpr std::size_t max_block = 4096;
+    static constexpr std::size_t classes = 7; // 64, 128, ..., 4096
+    static constexpr std::size_t max_cached = 256;
+
+  private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+  };
+
+  /**
+   * @brief Process-wide frame pool (per-thread caches).
+   */
+  FramePool &frame_pool() noexcept;
+
+  template <class Ex>
+  concept has_allocating_run_async =
+      requires(Ex ex, std::pmr::memory_resource *mr) { capy::run_async(ex, mr); };
+
+  /**
+   * @brief run_async() with frames drawn from the frame pool.
+   *
+   * Use as `launcher(ex)(make_task())`: the backend installs the allocator
+   * before the task expression is evaluated, so the task frame and every
+   * frame it creates come from the pool. Falls back to the default
+   * allocator on backends without allocator-aware launch.
+   */
+  template <class Ex>
+  auto launcher(Ex ex)
+  {
+    if constexpr (has_allocating_run_async<Ex>)
+    {
+      return capy::run_async(ex, static_cast<std::pmr::memory_resource *>(&frame_pool()));
+    }
+    else
+    {
+      return capy::run_async(ex);
+    }
+  }
+
+} // namespace vix::net_corosio::detail
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <vix/net_corosio/error.hpp>
+
+#include <cstddef>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#endif
+
+namespace vix::net_corosio::detail
+{
+  /**
+   * @brief True on platforms where the raw-descriptor helpers below work.
+   */
+#if defined(_WIN32)
+  inline constexpr bool has_posix_sockets = false;
+#else
+  inline constexpr bool has_posix_sockets = true;
+#endif
+
+  template <class T>
+  concept has_native_handle = requires(T &t) { t.native_handle(); };
+
+  /**
+   * @brief Returns the OS descriptor behind a backend socket/acceptor, or -1.
+   *
+   * Only meaningful on POSIX platforms; the backend object keeps ownership.
+   */
+  template <class T>
+  int native_fd(T &obj) noexcept
+  {
+    if constexpr (has_posix_sockets && has_native_handle<T>)
+    {
+      return static_cast<int>(obj.native_handle());
+    }
+    else
+    {
+      (void)obj;
+      return -1;
+    }
+  }
+
+  /**
+   * @brief setsockopt() wrapper mapped to the net_corosio error model.
+   *
+   * An option or value the kernel lacks (ENOPROTOOPT, EOPNOTSUPP, and
+   * ENOENT for a TCP_CONGESTION algorithm that is not available) is
+   * not_supported; a rejected value (EINVAL) is invalid_argument.
+   */
+  inline Error set_option(int fd, int level, int name, const void *value, unsigned len) noexcept
+  {
+#if defined(_WIN32)
+    (void)fd;
+    (void)level;
+    (void)name;
+    (void)value;
+    (void)len;
+    return Error{ErrorCode::not_supported};
+#else
+    if (fd < 0)
+      return Error{ErrorCode::invalid_state};
+
+    if (::setsockopt(fd, level, name, value, static_cast<socklen_t>(len)) == 0)
+      return Error{ErrorCode::none};
+
+    switch (errno)
+    {
+    case ENOPROTOOPT:
+    case EOPNOTSUPP:
+#if defined(ENOTSUP) && ENOTSUP != EOPNOTSUPP
+    case ENOTSUP:
+#endif
+    case ENOENT:
+      return Error{ErrorCode::not_supported};
+    case EINVAL:
+      return Error{ErrorCode::invalid_argument};
+    case EBADF:
+    case ENOTSOCK:
+      return Error{ErrorCode::invalid_state};
+    default:
+      return Error{ErrorCode::unknown};
+    }
+#endif
+  }
+
+  inline Error set_int_option(int fd, int level, int name, int value) noexcept
+  {
+    return set_option(fd, level, name, &value, sizeof(value));
+  }
+
+  /**
+   * @brief Outcome of a non-blocking recv()/send() attempt.
+   *
+   * bytes > 0 means progress. would_block and closed (orderly EOF on recv)
+   * are reported separately; anything else is an error, or an unsupported
+   * platform.
+   */
+  struct NativeIo final
+  {
+    std::size_t bytes{0};
+    bool would_block{false};
+    bool closed{false};
+
+    bool progressed() const noexcept { return bytes != 0; }
+  };
+
+  inline NativeIo try_recv(int fd, void *data, std::size_t size) noexcept
+  {
+#if defined(_WIN32)
+    (void)fd;
+    (void)data;
+    (void)size;
+    return NativeIo{};
+#else
+    if (fd < 0)
+      return NativeIo{};
+
+    for (;;)
+    {
+      const ssize_t n = ::recv(fd, data, size, MSG_DONTWAIT);
+      if (n > 0)
+        return NativeIo{static_cast<std::size_t>(n), false, false};
+
+      if (n == 0)
+        return NativeIo{0, false, true};
+
+      if (errno == EINTR)
+        continue;
+
+      return NativeIo{0, errno == EAGAIN || errno == EWOULDBLOCK, false};
+    }
+#endif
+  }
+
+  /**
+   * @brief Look at the receive queue without consuming it: one byte
+   * pending, would_block when idle, closed on EOF.
+   */
+  inline NativeIo try_peek(int fd) noexcept
+  {
+#if defined(_WIN32)
+    (void)fd;
+    return NativeIo{};
+#else
+    if (fd < 0)
+      return NativeIo{};
+
+    char probe = 0;
+    for (;;)
+    {
+      const ssize_t n = ::recv(fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+      if (n > 0)
+        return NativeIo{static_cast<std::size_t>(n), false, false};
+
+      if (n == 0)
+        return NativeIo{0, false, true};
+
+      if (errno == EINTR)
+        continue;
+
+      return NativeIo{0, errno == EAGAIN || errno == EWOULDBLOCK, false};
+    }
+#endif
+  }
+
+  inline NativeIo try_send(int fd, const void *data, std::size_t size) noexcept
+  {
+#if defined(_WIN32)
+    (void)fd;
+    (void)data;
+    (void)size;
+    return NativeIo{};
+#else
+    if (fd < 0)
+      return NativeIo{};
+
+#if defined(MSG_NOSIGNAL)
+    constexpr int flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#else
+    constexpr int flags = MSG_DONTWAIT;
+#endif
+
+    for (;;)
+    {
+      const ssize_t n = ::send(fd, data, size, flags);
+      if (n > 0)
+        return NativeIo{static_cast<std::size_t>(n), false, false};
+
+      if (n < 0 && errno == EINTR)
+        continue;
+
+      return NativeIo{0, n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK), false};
+    }
+#endif
+  }
+
+#if !defined(_WIN32)
+  /**
+   * @brief Scatter/gather forms of try_recv()/try_send() (one syscall).
+   */
+  inline NativeIo try_recvv(int fd, ::iovec *iov, std::size_t count) noexcept
+  {
+    if (fd < 0 || count == 0)
+      return NativeIo{};
+
+    ::msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(count);
+
+    for (;;)
+    {
+      const ssize_t n = ::recvmsg(fd, &msg, MSG_DONTWAIT);
+      if (n > 0)
+        return NativeIo{static_cast<std::size_t>(n), false, false};
+
+      if (n == 0)
+        return NativeIo{0, false, true};
+
+      if (errno == EINTR)
+        continue;
+
+      return NativeIo{0, errno == EAGAIN || errno == EWOULDBLOCK, false};
+    }
+  }
+
+  inline NativeIo try_sendv(int fd, const ::iovec *iov, std::size_t count) noexcept
+  {
+    if (fd < 0 || count == 0)
+      return NativeIo{};
+
+    ::msghdr msg{};
+    msg.msg_iov = const_cast<::iovec *>(iov);
+    msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(count);
+
+#if defined(MSG_NOSIGNAL)
+    constexpr int flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#else
+    constexpr int flags = MSG_DONTWAIT;
+#endif
+
+    for (;;)
+    {
+      const ssize_t n = ::sendmsg(fd, &msg, flags);
+      if (n > 0)
+        return NativeIo{static_cast<std::size_t>(n), false, false};
+
+      if (n < 0 && errno == EINTR)
+        continue;
+
+      return NativeIo{0, n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK), false};
+    }
+  }
+#endif
+
+  /**
+   * @brief Zero-timeout readiness probe. Never blocks.
+   *
+   * Readable includes EOF and pending errors, so a subsequent read will not
+   * wait for the peer. Returns false on unsupported platforms.
+   */
+  inline bool poll_ready(int fd, bool for_write) noexcept
+  {
+#if defined(_WIN32)
+    (void)fd;
+    (void)for_write;
+    return false;
+#else
+    if (fd < 0)
+      return false;
+
+    ::pollfd p{};
+    p.fd = fd;
+    p.events = static_cast<short>(for_write ? POLLOUT : POLLIN);
+
+    for (;;)
+    {
+      const int n = ::poll(&p, 1, 0);
+      if (n >= 0)
+        return n > 0;
+
+      if (errno != EINTR)
+        return false;
+    }
+#endif
+  }
+
+} // namespace vix::net_corosio::detail
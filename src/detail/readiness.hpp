@@ -0,0 +1,139 @@
+#pragma once
+
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/executor.hpp>
+
+#include "timer_service.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace vix::net_corosio::detail
+{
+  /**
+   * @brief True where ReadinessService can wait (Linux epoll).
+   */
+#if defined(__linux__)
+  inline constexpr bool has_readiness_wait = true;
+#else
+  inline constexpr bool has_readiness_wait = false;
+#endif
+
+  class ReadinessService;
+
+  /**
+   * @brief One parked readiness wait, living in the waiting coroutine's frame.
+   */
+  struct ReadyWait final
+  {
+    int fd{-1};
+    bool write{false};
+    Executor ex{};
+
+    // Guarded by the service's lock once svc is set.
+    ReadinessService *svc{nullptr};
+    std::coroutine_handle<> waiter{};
+    Error result{ErrorCode::unknown};
+    bool canceled{false};
+  };
+
+  /**
+   * @brief Per-Context descriptor readiness waits, without reading or writing.
+   *
+   * The backend reactor only completes reads and writes, so readiness comes
+   * from a private epoll instance served by one thread, started on the first
+   * wait. The fd stays registered with the backend too; interest here is
+   * one-shot and removed as soon as the wait completes. Completions resume
+   * the waiter through its executor, never on the epoll thread.
+   *
+   * While any wait is parked, a far-future entry on the timer wheel keeps
+   * Context::run() from returning, the way an armed timer does.
+   */
+  class ReadinessService final
+  {
+  public:
+    explicit ReadinessService(TimerService &timers) noexcept;
+
+    ReadinessService(const ReadinessService &) = delete;
+    ReadinessService &operator=(const ReadinessService &) = delete;
+
+    // Stops the epoll thread; waits still parked are dropped.
+    ~ReadinessService();
+
+    struct Awaiter final
+    {
+      ReadinessService &svc;
+      ReadyWait &w;
+
+      bool await_ready() const noexcept { return false; }
+
+      template <class... Env>
+      bool await_suspend(std::coroutine_handle<> h, Env &&...) noexcept
+      {
+        return svc.park(w, h);
+      }
+
+      Error await_resume() const noexcept { return w.result; }
+    };
+
+    /**
+     * @brief Park until w.fd is readable (data, EOF, error) or writable.
+     *
+     * Completes with invalid_state when the fd already has a waiter in the
+     * same direction, canceled after cancel() or cancel_fd().
+     */
+    Awaiter wait(ReadyWait &w) noexcept { return Awaiter{*this, w}; }
+
+    /**
+     * @brief Complete w with canceled if still parked. Thread-safe.
+     */
+    bool cancel(ReadyWait &w) noexcept;
+
+    /**
+     * @brief DeadlineGuard target: cancel(*static_cast<ReadyWait *>(w)).
+     */
+    static void cancel_wait(void *w) noexcept;
+
+    /**
+     * @brief Cancel every wait on fd. Call before closing fd.
+     */
+    void cancel_fd(int fd) noexcept;
+
+  private:
+    struct Entry final
+    {
+      std::uint32_t gen{0};
+      ReadyWait *reader{nullptr};
+      ReadyWait *writer{nullptr};
+    };
+
+    bool park(ReadyWait &w, std::coroutine_handle<> h) noexcept;
+
+    // Both require mu_.
+    bool start_locked() noexcept;
+    bool update_locked(int fd, Entry &e, bool added) noexcept;
+    void released_locked(std::size_t n) noexcept;
+
+    void run() noexcept;
+
+    static void complete(ReadyWait &w, Error e) noexcept;
+
+    TimerService &timers_;
+    TimerNode keepalive_{};
+
+    std::mutex mu_{};
+    std::unordered_map<int, Entry> fds_{};
+    std::size_t parked_{0};
+    std::uint32_t next_gen_{0};
+
+    int epfd_{-1};
+    int wakefd_{-1};
+    std::atomic<bool> stopping_{false};
+    std::thread thread_{};
+  };
+
+} // namespace vix::net_corosio::detail
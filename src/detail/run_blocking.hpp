@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vix/net_corosio/context.hpp>
+
+#include <boost/corosio.hpp>
+#include <boost/capy/task.hpp>
+
+#include "frame_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace vix::net_corosio::detail
+{
+  namespace corosio = boost::corosio;
+  namespace capy = boost::capy;
+
+  template <class Task>
+  struct task_value;
+
+  template <class T>
+  struct task_value<capy::task<T>>
+  {
+    using type = T;
+  };
+
+  /**
+   * @brief Drive a task to completion from the calling thread.
+   *
+   * This is the bridge between the awaitable API and the blocking wrappers:
+   * the task is launched on the Context's io_context, then
+   * - if other threads are already inside Context::run(), the caller
+   *   waits for them to complete the task, rechecking every few
+   *   milliseconds that they are still running;
+   * - otherwise, or once the runners have exited without completing it,
+   *   the loop is pumped with run_one() on this thread (restarting a
+   *   stopped io_context, since the task must not outlive this call).
+   *
+   * The task is created by `make` inside the launched wrapper, so both
+   * frames come from the frame pool and a steady stream of blocking calls
+   * does not touch the global heap.
+   */
+  template <class MakeTask>
+  auto run_blocking(Context &ctx, MakeTask make)
+  {
+    using T = typename task_value<std::invoke_result_t<MakeTask &>>::type;
+
+    auto &ioc = *static_cast<corosio::io_context *>(ctx.native_handle());
+
+    constexpr std::chrono::milliseconds recheck{10};
+
+    std::atomic<bool> done{false};
+    std::mutex m;
+    std::condition_variable cv;
+    std::optional<T> out;
+
+    auto wrapper = [&]() -> capy::task<void>
+    {
+      out.emplace(co_await make());
+
+      // Notify under the lock: the waiter may return (and destroy cv) as
+      // soon as it sees done.
+      std::lock_guard<std::mutex> lock(m);
+      done.store(true, std::memory_order_release);
+      cv.notify_one();
+    };
+
+    launcher(ioc.get_executor())(wrapper());
+
+    while (!done.load(std::memory_order_acquire))
+    {
+      // running() can change under us: the runners may stop or exit before
+      // they reach the task, so never wait on them unconditionally.
+      if (ctx.running() && !ctx.running_in_this_thread())
+      {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait_for(lock, recheck, [&]
+                    { return done.load(std::memory_order_acquire); });
+        continue;
+      }
+
+      if (ioc.run_one() == 0 && !done.load(std::memory_order_acquire))
+        ioc.restart();
+    }
+
+    return std::move(*out);
+  }
+
+} // namespace vix::net_corosio::detail
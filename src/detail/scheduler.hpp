@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vix/net_corosio/executor.hpp>
+
+#include <boost/corosio.hpp>
+#include <boost/capy/task.hpp>
+
+#include <atomic>
+
+namespace vix::net_corosio::detail
+{
+  namespace corosio = boost::corosio;
+  namespace capy = boost::capy;
+
+  /**
+   * @brief Cross-thread submission queue owned by each Context.
+   *
+   * Producers push onto a lock-free intrusive stack. Only the push that finds
+   * the queue empty schedules a drain on the io_context, so a burst of
+   * submissions costs one loop wakeup. The drain takes the whole batch with a
+   * single exchange and runs it in submission order.
+   *
+   * At most one drain runs at a time, which keeps the queue single-consumer
+   * even when the loop itself runs on several threads.
+   */
+  class Scheduler final
+  {
+  public:
+    explicit Scheduler(corosio::io_context &ioc) noexcept;
+
+    Scheduler(const Scheduler &) = delete;
+    Scheduler &operator=(const Scheduler &) = delete;
+
+    // Discards (without running) anything still queued.
+    ~Scheduler();
+
+    void submit(WorkItem *work) noexcept;
+
+    bool running_in_this_thread() const noexcept;
+
+    corosio::io_context &ioc() noexcept { return ioc_; }
+
+  private:
+    capy::task<void> drain();
+
+    static WorkItem *reverse(WorkItem *list) noexcept;
+
+    corosio::io_context &ioc_;
+    std::atomic<WorkItem *> head_{nullptr};
+    std::atomic<bool> scheduled_{false};
+  };
+
+  /**
+   * @brief Scheduler whose loop the calling thread is running, if any.
+   *
+   * Set by Context::run() for the duration of the loop.
+   */
+  const Scheduler *&current_scheduler() noexcept;
+
+} // namespace vix::net_corosio::detail
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <vix/net_corosio/error.hpp>
+
+#include "native.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#endif
+
+namespace vix::net_corosio::detail
+{
+  /**
+   * @brief What send_file() reads from.
+   */
+  struct FileSource final
+  {
+    int fd{-1};
+    bool pipe{false};          // no offsets: splice()/read()
+    std::uint64_t size{0};     // regular files only
+  };
+
+  /**
+   * @brief Classify fd. Returns invalid_argument for anything that is
+   * neither a regular file nor a pipe.
+   */
+  inline Error inspect_source(int fd, FileSource &out) noexcept
+  {
+#if defined(_WIN32)
+    (void)fd;
+    (void)out;
+    return Error{ErrorCode::not_supported};
+#else
+    struct stat st{};
+    if (fd < 0 || ::fstat(fd, &st) != 0)
+      return Error{ErrorCode::invalid_argument};
+
+    out.fd = fd;
+
+    if (S_ISREG(st.st_mode))
+    {
+      out.pipe = false;
+      out.size = static_cast<std::uint64_t>(st.st_size);
+      return Error{ErrorCode::none};
+    }
+
+    if (S_ISFIFO(st.st_mode))
+    {
+      out.pipe = true;
+      out.size = 0;
+      return Error{ErrorCode::none};
+    }
+
+    return Error{ErrorCode::invalid_argument};
+#endif
+  }
+
+  /**
+   * @brief Make sure kernel-side transfers on fd never block the loop.
+   *
+   * sendfile()/splice() take no MSG_DONTWAIT-style flag.
+   */
+  inline void ensure_nonblocking(int fd) noexcept
+  {
+#if !defined(_WIN32)
+    if (fd < 0)
+      return;
+
+    const int flags = ::fcntl(fd, F_GETFL, 0);
+    if (flags >= 0 && (flags & O_NONBLOCK) == 0)
+      (void)::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+#else
+    (void)fd;
+#endif
+  }
+
+  /**
+   * @brief True where try_send_file() moves data without a user-space copy.
+   */
+#if defined(__linux__)
+  inline constexpr bool has_send_file = true;
+#else
+  inline constexpr bool has_send_file = false;
+#endif
+
+  /**
+   * @brief One sendfile()/splice() step from src into the socket.
+   *
+   * would_block covers both a full socket buffer and an empty pipe;
+   * closed means the source hit end of file. Platforms without a
+   * file-to-socket syscall report would_block so the caller takes the
+   * copying path.
+   */
+  inline NativeIo try_send_file(int sock, const FileSource &src, std::uint64_t offset,
+                                std::size_t count) noexcept
+  {
+#if defined(__linux__)
+    if (sock < 0 || src.fd < 0 || count == 0)
+      return NativeIo{};
+
+    for (;;)
+    {
+      ssize_t n = 0;
+
+      if (src.pipe)
+      {
+        n = ::splice(src.fd, nullptr, sock, nullptr, count,
+                     SPLICE_F_MOVE | SPLICE_F_NONBLOCK | SPLICE_F_MORE);
+      }
+      else
+      {
+        auto off = static_cast<off_t>(offset);
+        n = ::sendfile(sock, src.fd, &off, count);
+      }
+
+      if (n > 0)
+        return NativeIo{static_cast<std::size_t>(n), false, false};
+
+      if (n == 0)
+        return NativeIo{0, false, true};
+
+      if (errno == EINTR)
+        continue;
+
+      return NativeIo{0, errno == EAGAIN || errno == EWOULDBLOCK, false};
+    }
+#else
+    (void)sock;
+    (void)src;
+    (void)offset;
+    (void)count;
+    return NativeIo{0, true, false};
+#endif
+  }
+
+  /**
+   * @brief Copy up to size bytes from the source into data.
+   *
+   * pread() for files, read() for pipes. closed means end of file.
+   */
+  inline NativeIo read_source(const FileSource &src, std::uint64_t offset, void *data,
+                              std::size_t size) noexcept
+  {
+#if defined(_WIN32)
+    (void)src;
+    (void)offset;
+    (void)data;
+    (void)size;
+    return NativeIo{};
+#else
+    for (;;)
+    {
+      const ssize_t n = src.pipe
+                            ? ::read(src.fd, data, size)
+                            : ::pread(src.fd, data, size, static_cast<off_t>(offset));
+
+      if (n > 0)
+        return NativeIo{static_cast<std::size_t>(n), false, false};
+
+      if (n == 0)
+        return NativeIo{0, false, true};
+
+      if (errno == EINTR)
+        continue;
+
+      return NativeIo{0, errno == EAGAIN || errno == EWOULDBLOCK, false};
+    }
+#endif
+  }
+
+  /**
+   * @brief open(path, O_RDONLY) for send_file(path, ...), or -1.
+   */
+  inline int open_for_send(const char *path) noexcept
+  {
+#if defined(_WIN32)
+    (void)path;
+    return -1;
+#else
+    int flags = O_RDONLY;
+#if defined(O_CLOEXEC)
+    flags |= O_CLOEXEC;
+#endif
+    return ::open(path, flags);
+#endif
+  }
+
+  inline void close_file(int fd) noexcept
+  {
+#if !defined(_WIN32)
+    if (fd >= 0)
+      (void)::close(fd);
+#else
+    (void)fd;
+#endif
+  }
+
+} // namespace vix::net_corosio::detail
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/socket_options.hpp>
+
+#include "native.hpp"
+
+#include <climits>
+#include <cstddef>
+
+#if !defined(_WIN32)
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
+namespace vix::net_corosio::detail
+{
+  inline Error set_size_option(int fd, int level, int name, std::size_t value) noexcept
+  {
+    if (value > static_cast<std::size_t>(INT_MAX))
+      return Error{ErrorCode::invalid_argument};
+
+    return set_int_option(fd, level, name, static_cast<int>(value));
+  }
+
+  inline Error set_keep_alive(int fd, const KeepAlive &k) noexcept
+  {
+#if defined(_WIN32)
+    (void)fd;
+    (void)k;
+    return Error{ErrorCode::not_supported};
+#else
+    if (Error e = set_int_option(fd, SOL_SOCKET, SO_KEEPALIVE, k.enabled ? 1 : 0))
+      return e;
+
+    if (!k.enabled)
+      return Error{ErrorCode::none};
+
+    if (k.idle.count() > 0)
+    {
+#if defined(TCP_KEEPIDLE)
+      if (Error e = set_int_option(fd, IPPROTO_TCP, TCP_KEEPIDLE, static_cast<int>(k.idle.count())))
+        return e;
+#elif defined(TCP_KEEPALIVE)
+      if (Error e = set_int_option(fd, IPPROTO_TCP, TCP_KEEPALIVE, static_cast<int>(k.idle.count())))
+        return e;
+#else
+      return Error{ErrorCode::not_supported};
+#endif
+    }
+
+    if (k.interval.count() > 0)
+    {
+#if defined(TCP_KEEPINTVL)
+      if (Error e = set_int_option(fd, IPPROTO_TCP, TCP_KEEPINTVL, static_cast<int>(k.interval.count())))
+        return e;
+#else
+      return Error{ErrorCode::not_supported};
+#endif
+    }
+
+    if (k.probes > 0)
+    {
+#if defined(TCP_KEEPCNT)
+      if (Error e = set_int_option(fd, IPPROTO_TCP, TCP_KEEPCNT, k.probes))
+        return e;
+#else
+      return Error{ErrorCode::not_supported};
+#endif
+    }
+
+    return Error{ErrorCode::none};
+#endif
+  }
+
+  inline Error set_quick_ack(int fd, bool enabled) noexcept
+  {
+#if defined(TCP_QUICKACK)
+    return set_int_option(fd, IPPROTO_TCP, TCP_QUICKACK, enabled ? 1 : 0);
+#else
+    (void)fd;
+    (void)enabled;
+    return Error{ErrorCode::not_supported};
+#endif
+  }
+
+  /**
+   * @brief Server-side TCP Fast Open: accept data in SYNs, queue_length
+   * bounding pending TFO requests. Must precede listen().
+   */
+  inline Error set_fast_open(int fd, int queue_length) noexcept
+  {
+#if defined(TCP_FASTOPEN)
+    return set_int_option(fd, IPPROTO_TCP, TCP_FASTOPEN, queue_length);
+#else
+    (void)fd;
+    (void)queue_length;
+    return Error{ErrorCode::not_supported};
+#endif
+  }
+
+  /**
+   * @brief Client-side TCP Fast Open (Linux 4.11+).
+   *
+   * connect() then returns at once and the first send carries the SYN and
+   * the data. Without a cookie for the server, the kernel does a regular
+   * handshake and sends the data afterwards.
+   */
+  inline Error set_fast_open_connect(int fd) noexcept
+  {
+#if defined(TCP_FASTOPEN_CONNECT)
+    return set_int_option(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, 1);
+#else
+    (void)fd;
+    return Error{ErrorCode::not_supported};
+#endif
+  }
+
+  /**
+   * @brief Apply every field set in opts to fd.
+   *
+   * All fields are attempted; the first failure is returned.
+   */
+  inline Error apply_options(int fd, const SocketOptions &opts) noexcept
+  {
+#if defined(_WIN32)
+    (void)fd;
+    return opts.empty() ? Error{ErrorCode::none} : Error{ErrorCode::not_supported};
+#else
+    if (fd < 0)
+      return opts.empty() ? Error{ErrorCode::none} : Error{ErrorCode::not_supported};
+
+    Error first{ErrorCode::none};
+    const auto keep = [&](Error e)
+    {
+      if (e && first.ok())
+        first = e;
+    };
+
+    if (opts.no_delay)
+      keep(set_int_option(fd, IPPROTO_TCP, TCP_NODELAY, *opts.no_delay ? 1 : 0));
+
+    if (opts.send_buffer_bytes)
+      keep(set_size_option(fd, SOL_SOCKET, SO_SNDBUF, *opts.send_buffer_bytes));
+
+    if (opts.receive_buffer_bytes)
+      keep(set_size_option(fd, SOL_SOCKET, SO_RCVBUF, *opts.receive_buffer_bytes));
+
+    if (opts.keep_alive)
+      keep(set_keep_alive(fd, *opts.keep_alive));
+
+    if (opts.quick_ack)
+      keep(set_quick_ack(fd, *opts.quick_ack));
+
+    if (opts.cork)
+    {
+#if defined(TCP_CORK)
+      keep(set_int_option(fd, IPPROTO_TCP, TCP_CORK, *opts.cork ? 1 : 0));
+#elif defined(TCP_NOPUSH)
+      keep(set_int_option(fd, IPPROTO_TCP, TCP_NOPUSH, *opts.cork ? 1 : 0));
+#else
+      keep(Error{ErrorCode::not_supported});
+#endif
+    }
+
+    if (opts.congestion)
+    {
+#if defined(TCP_CONGESTION)
+      const std::string &name = *opts.congestion;
+      keep(set_option(fd, IPPROTO_TCP, TCP_CONGESTION, name.data(), static_cast<unsigned>(name.size())));
+#else
+      keep(Error{ErrorCode::not_supported});
+#endif
+    }
+
+    if (opts.not_sent_lowat)
+    {
+#if defined(TCP_NOTSENT_LOWAT)
+      keep(set_size_option(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, *opts.not_sent_lowat));
+#else
+      keep(Error{ErrorCode::not_supported});
+#endif
+    }
+
+    return first;
+#endif
+  }
+
+} // namespace vix::net_corosio::detail
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <boost/corosio.hpp>
+#include <boost/capy/task.hpp>
+
+#include "timer_wheel.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace vix::net_corosio::detail
+{
+  namespace corosio = boost::corosio;
+  namespace capy = boost::capy;
+
+  /**
+   * @brief Per-Context timer queue: one timing wheel, 1 ms resolution.
+   *
+   * Arming and cancelling a timer only touches the wheel under a mutex, so
+   * both are O(1) regardless of how many timers are armed. One sleeper
+   * coroutine per service waits on a backend timer until the wheel's next
+   * deadline, and exits once the wheel is empty so it never keeps
+   * Context::run() alive on its own. When a timer is armed earlier than the
+   * sleeper's wake-up, or the last timer is cancelled, a retarget task is
+   * posted to the loop; it cancels the backend wait so the sleeper
+   * recomputes its due time (or exits).
+   *
+   * Expired nodes are fired on a loop thread, outside the lock, in batches.
+   * Deadlines are rounded up to the next tick: timers never fire early.
+   */
+  class TimerService final
+  {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    explicit TimerService(corosio::io_context &ioc) noexcept;
+
+    TimerService(const TimerService &) = delete;
+    TimerService &operator=(const TimerService &) = delete;
+
+    ~TimerService() = default;
+
+    /**
+     * @brief Arm n to fire at `at`. n must not be armed.
+     *
+     * Thread-safe. n->fire runs exactly once unless cancel() wins.
+     */
+    void schedule(TimerNode &n, clock::time_point at);
+
+    /**
+     * @brief Disarm n. Thread-safe.
+     *
+     * Returns false when n was not armed, including when it is firing
+     * right now; the fire callback then still runs (or has run).
+     */
+    bool cancel(TimerNode &n) noexcept;
+
+    /**
+     * @brief Number of armed timers.
+     */
+    std::size_t size() const noexcept;
+
+  private:
+    static constexpr std::uint64_t no_sleeper = ~std::uint64_t{0};
+
+    std::uint64_t tick_floor(clock::time_point t) const noexcept;
+    std::uint64_t tick_ceil(clock::time_point t) const noexcept;
+
+    // Both require mu_. Tick of the wheel's next check; the wheel is not empty.
+    std::uint64_t next_check() const noexcept;
+    bool needs_retarget() const noexcept;
+
+    void start_sleeper();
+    void post_retarget() noexcept;
+    capy::task<void> sleep();
+    capy::task<void> retarget();
+
+    static void fire_all(TimerNode *expired) noexcept;
+
+    corosio::io_context &ioc_;
+    const clock::time_point epoch_;
+
+    mutable std::mutex mu_{};
+    TimerWheel wheel_{};
+
+    // The sleeper coroutine is alive; it is the only one.
+    bool sleeping_{false};
+    bool retarget_pending_{false};
+
+    // Tick the sleeper's backend wait is set for, or no_sleeper while it is
+    // awake. backend_ is that wait's timer, living in the sleeper's frame.
+    std::uint64_t sleeper_due_{no_sleeper};
+    corosio::timer *backend_{nullptr};
+  };
+
+} // namespace vix::net_corosio::detail
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace vix::net_corosio::detail
+{
+  /**
+   * @brief Intrusive entry of the timer wheel.
+   *
+   * The owner embeds the node and keeps it alive while it is armed or firing.
+   * `fire` runs on a loop thread, outside the wheel lock, and must be short:
+   * typically it records a result and posts a continuation.
+   */
+  struct TimerNode
+  {
+    enum : std::uint8_t
+    {
+      idle = 0,
+      armed,
+      firing
+    };
+
+    TimerNode *prev{nullptr};
+    TimerNode *next{nullptr};
+    TimerNode **slot{nullptr};
+
+    std::uint64_t due{0};
+
+    void (*fire)(TimerNode *self) noexcept {nullptr};
+    void *user{nullptr};
+
+    std::atomic<std::uint8_t> state{idle};
+
+    bool linked() const noexcept { return slot != nullptr; }
+  };
+
+  /**
+   * @brief Hierarchical timing wheel (Varghese & Lauck, cascading variant).
+   *
+   * Time is measured in ticks. Level 0 has 256 one-tick slots; levels 1..4
+   * have 64 slots, each 64x coarser than the level below, covering ~49 days
+   * of 1 ms ticks. Insert and remove are O(1); entries migrate down a level
+   * when the level below wraps.
+   *
+   * Not thread-safe: callers serialize access.
+   */
+  class TimerWheel final
+  {
+  public:
+    static constexpr std::size_t level0_bits = 8;
+    static constexpr std::size_t level_bits = 6;
+    static constexpr std::size_t upper_levels = 4;
+
+    static constexpr std::size_t level0_size = std::size_t{1} << level0_bits;
+    static constexpr std::size_t level_size = std::size_t{1} << level_bits;
+
+    static constexpr std::uint64_t max_span =
+        std::uint64_t{1} << (level0_bits + level_bits * upper_levels);
+
+    TimerWheel() = default;
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    std::uint64_t current() const noexcept { return current_; }
+    std::size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+
+    /**
+     * @brief Arm n to expire at tick `due` (clamped to the next tick).
+     */
+    void insert(TimerNode &n, std::uint64_t due) noexcept
+    {
+      n.due = due > current_ ? due : current_ + 1;
+      place(n);
+      ++count_;
+    }
+
+    /**
+     * @brief Disarm n. No-op when n is not linked.
+     */
+    void remove(TimerNode &n) noexcept
+    {
+      if (!n.linked())
+        return;
+
+      unlink(n);
+      --count_;
+    }
+
+    /**
+     * @brief Process every tick up to and including `now`.
+     *
+     * Returns the expired nodes as a list chained through `next`,
+     * already unlinked from the wheel.
+     */
+    TimerNode *advance(std::uint64_t now) noexcept
+    {
+      TimerNode *expired = nullptr;
+
+      if (count_ == 0)
+      {
+        if (now > current_)
+          current_ = now;
+        return nullptr;
+      }
+
+      while (count_ != 0)
+      {
+        // Jump straight to the next tick that has work; skipped ticks are
+        // guaranteed to have nothing to expire or cascade.
+        const std::uint64_t next = current_ + ticks_until_next_check();
+        if (next > now)
+          break;
+
+        current_ = next;
+
+        if ((current_ & (level0_size - 1)) == 0)
+          cascade();
+
+        TimerNode *list = take(level0_[current_ & (level0_size - 1)]);
+        while (list)
+        {
+          TimerNode *following = list->next;
+
+          if (list->due > current_)
+          {
+            // Clamped far-future entry: not due yet, re-file it.
+            place(*list);
+          }
+          else
+          {
+            list->next = expired;
+            expired = list;
+            --count_;
+          }
+
+          list = following;
+        }
+      }
+
+      if (current_ < now)
+        current_ = now;
+
+      return expired;
+    }
+
+    /**
+     * @brief Ticks from current() until the wheel next needs attention.
+     *
+     * This is the distance to the next non-empty level-0 slot, or to the
+     * first level-0 wrap that cascades a non-empty coarser slot. The answer
+     * may be early (never late) when a coarser level holds entries for its
+     * next revolution. Returns 0 when the wheel is empty.
+     */
+    std::uint64_t ticks_until_next_check() const noexcept
+    {
+      if (count_ == 0)
+        return 0;
+
+      const std::uint64_t pos = current_ & (level0_size - 1);
+      const std::uint64_t to_wrap = level0_size - pos;
+
+      for (std::uint64_t i = 1; i < to_wrap; ++i)
+      {
+        if (level0_[(pos + i) & (level0_size - 1)])
+          return i;
+      }
+
+      // Entries behind pos belong to the next revolution of level 0.
+      for (std::uint64_t i = 0; i <= pos; ++i)
+      {
+        if (level0_[i])
+          return to_wrap;
+      }
+
+      // At each wrap `base`, cascade() empties the slot of `base` on level 1,
+      // and on the next level too whenever that index is 0.
+      std::uint64_t base = current_ + to_wrap;
+      std::uint64_t best = ~std::uint64_t{0};
+
+      for (std::size_t level = 1; level <= upper_levels; ++level)
+      {
+        const auto &slots = upper_[level - 1];
+        const std::size_t shift = shift_of(level);
+        const std::size_t idx = (base >> shift) & (level_size - 1);
+
+        for (std::size_t k = idx; k < level_size; ++k)
+        {
+          if (slots[k])
+          {
+            best = std::min(best, base + (std::uint64_t{k - idx} << shift));
+            break;
+          }
+        }
+
+        if (idx == 0)
+          continue; // This level wraps at `base`: the next level cascades there too.
+
+        const std::uint64_t wrap = base + (std::uint64_t{level_size - idx} << shift);
+
+        for (std::size_t k = 0; k < idx && best > wrap; ++k)
+        {
+          if (slots[k])
+            best = wrap;
+        }
+
+        // Coarser levels only cascade from `wrap` onwards.
+        if (best <= wrap)
+          return best - current_;
+
+        base = wrap;
+      }
+
+      return std::min(best, base) - current_;
+    }
+
+  private:
+    static constexpr std::size_t shift_of(std::size_t level) noexcept
+    {
+      // level >= 1
+      return level0_bits + level_bits * (level - 1);
+    }
+
+    void place(TimerNode &n) noexcept
+    {
+      if (n.due <= current_)
+      {
+        // Only reachable while cascading: expire in the tick being processed.
+        link(n, level0_[current_ & (level0_size - 1)]);
+        return;
+      }
+
+      const std::uint64_t delta = n.due - current_;
+
+      if (delta < level0_size)
+      {
+        link(n, level0_[n.due & (level0_size - 1)]);
+        return;
+      }
+
+      for (std::size_t level = 1; level <= upper_levels; ++level)
+      {
+        if (delta < (std::uint64_t{1} << (shift_of(level) + level_bits)))
+        {
+          link(n, upper_[level - 1][(n.due >> shift_of(level)) & (level_size - 1)]);
+          return;
+        }
+      }
+
+      // Beyond the wheel horizon: park at the horizon, re-filed on expiry.
+      const std::uint64_t parked = current_ + max_span - 1;
+      link(n, upper_[upper_levels - 1][(parked >> shift_of(upper_levels)) & (level_size - 1)]);
+    }
+
+    void cascade() noexcept
+    {
+      for (std::size_t level = 1; level <= upper_levels; ++level)
+      {
+        const std::size_t idx = (current_ >> shift_of(level)) & (level_size - 1);
+
+        TimerNode *list = take(upper_[level - 1][idx]);
+        while (list)
+        {
+          TimerNode *next = list->next;
+          place(*list);
+          list = next;
+        }
+
+        if (idx != 0)
+          break;
+      }
+    }
+
+    static void link(TimerNode &n, TimerNode *&head) noexcept
+    {
+      n.prev = nullptr;
+      n.next = head;
+      if (head)
+        head->prev = &n;
+      head = &n;
+      n.slot = &head;
+    }
+
+    static void unlink(TimerNode &n) noexcept
+    {
+      if (n.prev)
+        n.prev->next = n.next;
+      else
+        *n.slot = n.next;
+
+      if (n.next)
+        n.next->prev = n.prev;
+
+      n.prev = nullptr;
+      n.next = nullptr;
+      n.slot = nullptr;
+    }
+
+    // Detach a whole slot; nodes keep their `next` chain but are unlinked.
+    static TimerNode *take(TimerNode *&head) noexcept
+    {
+      TimerNode *list = head;
+      head = nullptr;
+
+      for (TimerNode *n = list; n; n = n->next)
+      {
+        n->prev = nullptr;
+        n->slot = nullptr;
+      }
+
+      return list;
+    }
+
+    std::array<TimerNode *, level0_size> level0_{};
+    std::array<std::array<TimerNode *, level_size>, upper_levels> upper_{};
+
+    std::uint64_t current_{0};
+    std::size_t count_{0};
+  };
+
+} // namespace vix::net_corosio::detail
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <coroutine>
+#include <mutex>
+#include <utility>
+
+namespace vix::net_corosio::detail
+{
+  /**
+   * @brief Single-slot park/unpark point for one coroutine.
+   *
+   * wait() suspends the awaiting coroutine; wake() resumes it inline on the
+   * calling thread. A wake() that arrives while nobody is parked is
+   * remembered, so the next wait() completes immediately. This makes the
+   * usual "check condition, then wait" loop safe when the waker runs on
+   * another loop thread.
+   *
+   * await_suspend() accepts (and ignores) any extra arguments so the awaiter
+   * also satisfies environment-passing awaitable protocols used by the
+   * backend task type.
+   */
+  class Waiter final
+  {
+  public:
+    struct Awaiter final
+    {
+      Waiter &w;
+
+      bool await_ready() const noexcept { return false; }
+
+      template <class... Env>
+      bool await_suspend(std::coroutine_handle<> h, Env &&...) noexcept
+      {
+        std::lock_guard<std::mutex> lock(w.mu_);
+
+        if (w.pending_)
+        {
+          w.pending_ = false;
+          return false;
+        }
+
+        w.h_ = h;
+        return true;
+      }
+
+      void await_resume() const noexcept {}
+    };
+
+    Awaiter wait() noexcept { return Awaiter{*this}; }
+
+    void wake()
+    {
+      std::coroutine_handle<> h{};
+
+      {
+        std::lock_guard<std::mutex> lock(mu_);
+        h = std::exchange(h_, std::coroutine_handle<>{});
+        if (!h)
+          pending_ = true;
+      }
+
+      if (h)
+        h.resume();
+    }
+
+  private:
+    std::mutex mu_{};
+    std::coroutine_handle<> h_{};
+    bool pending_{false};
+  };
+
+} // namespace vix::net_corosio::detail
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <vix/net_corosio/error.hpp>
+
+#include "native.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+namespace vix::net_corosio::detail
+{
+  /**
+   * @brief Completion notifications drained from the socket error queue.
+   */
+  struct ZeroCopyReap final
+  {
+    std::uint32_t completed{0}; // number of MSG_ZEROCOPY sends released
+    bool copied{false};         // the kernel fell back to copying
+  };
+
+  /**
+   * @brief Opt the socket into MSG_ZEROCOPY sends (SO_ZEROCOPY).
+   */
+  inline Error enable_zerocopy(int fd) noexcept
+  {
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    if (fd < 0)
+      return Error{ErrorCode::not_supported};
+
+    return set_int_option(fd, SOL_SOCKET, SO_ZEROCOPY, 1);
+#else
+    (void)fd;
+    return Error{ErrorCode::not_supported};
+#endif
+  }
+
+  /**
+   * @brief Non-blocking send that pins the pages instead of copying them.
+   *
+   * The buffer must stay untouched until reap_zerocopy() reports the send
+   * as completed. ENOBUFS (too many unreleased sends) reads as would_block.
+   */
+  inline NativeIo try_send_zerocopy(int fd, const void *data, std::size_t size) noexcept
+  {
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    if (fd < 0 || size == 0)
+      return NativeIo{};
+
+    constexpr int flags = MSG_ZEROCOPY | MSG_DONTWAIT | MSG_NOSIGNAL;
+
+    for (;;)
+    {
+      const ssize_t n = ::send(fd, data, size, flags);
+      if (n > 0)
+        return NativeIo{static_cast<std::size_t>(n), false, false};
+
+      if (n < 0 && errno == EINTR)
+        continue;
+
+      const bool again = n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS);
+      return NativeIo{0, again, false};
+    }
+#else
+    (void)fd;
+    (void)data;
+    (void)size;
+    return NativeIo{};
+#endif
+  }
+
+  /**
+   * @brief Drain MSG_ZEROCOPY notifications without blocking.
+   */
+  inline ZeroCopyReap reap_zerocopy(int fd) noexcept
+  {
+    ZeroCopyReap out{};
+
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    if (fd < 0)
+      return out;
+
+    for (;;)
+    {
+      alignas(::cmsghdr) char control[128];
+
+      ::msghdr msg{};
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+
+      const ssize_t n = ::recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+      if (n < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        break;
+      }
+
+      for (::cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm))
+      {
+        const bool recverr = (cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+                             (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR);
+        if (!recverr)
+          continue;
+
+        const auto *ee = reinterpret_cast<const ::sock_extended_err *>(CMSG_DATA(cm));
+        if (ee->ee_errno != 0 || ee->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+          continue;
+
+        // Inclusive range of send sequence numbers.
+        out.completed += ee->ee_data - ee->ee_info + 1;
+        if (ee->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+          out.copied = true;
+      }
+    }
+#else
+    (void)fd;
+#endif
+
+    return out;
+  }
+
+} // namespace vix::net_corosio::detail
@@ -0,0 +1,135 @@
+#include <vix/net_corosio/executor.hpp>
+
+#include <boost/corosio.hpp>
+#include <boost/capy/task.hpp>
+
+#include "detail/frame_pool.hpp"
+#include "detail/scheduler.hpp"
+
+#include <atomic>
+#include <exception>
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+
+namespace vix::net_corosio
+{
+  namespace detail
+  {
+    const Scheduler *&current_scheduler() noexcept
+    {
+      thread_local const Scheduler *current = nullptr;
+      return current;
+    }
+
+    Scheduler::Scheduler(corosio::io_context &ioc) noexcept
+        : ioc_(ioc)
+    {
+    }
+
+    Scheduler::~Scheduler()
+    {
+      WorkItem *w = head_.exchange(nullptr, std::memory_order_acquire);
+      while (w)
+      {
+        WorkItem *next = w->next;
+        w->complete(w, false);
+        w = next;
+      }
+    }
+
+    WorkItem *Scheduler::reverse(WorkItem *list) noexcept
+    {
+      WorkItem *out = nullptr;
+      while (list)
+      {
+        WorkItem *next = list->next;
+        list->next = out;
+        out = list;
+        list = next;
+      }
+      return out;
+    }
+
+    void Scheduler::submit(WorkItem *work) noexcept
+    {
+      WorkItem *old = head_.load(std::memory_order_relaxed);
+      do
+      {
+        work->next = old;
+      } while (!head_.compare_exchange_weak(old, work,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed));
+
+      // A non-empty queue already has a drain scheduled or running,
+      // and that drain re-checks the queue before it finishes.
+      if (old != nullptr)
+        return;
+
+      // Pairs with the fence in drain(): either this thread sees the drain's
+      // scheduled_ = false, or the drain sees this push.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      if (scheduled_.exchange(true, std::memory_order_acq_rel))
+        return;
+
+      try
+      {
+        launcher(ioc_.get_executor())(drain());
+      }
+      catch (...)
+      {
+        scheduled_.store(false, std::memory_order_release);
+      }
+    }
+
+    bool Scheduler::running_in_this_thread() const noexcept
+    {
+      return current_scheduler() == this;
+    }
+
+    capy::task<void> Scheduler::drain()
+    {
+      for (;;)
+      {
+        WorkItem *batch = reverse(head_.exchange(nullptr, std::memory_order_acquire));
+
+        while (batch)
+        {
+          WorkItem *next = batch->next;
+          batch->complete(batch, true);
+          batch = next;
+        }
+
+        scheduled_.store(false, std::memory_order_release);
+
+        // Work pushed after the exchange above may have skipped the wakeup.
+        // The fence keeps the re-check from being ordered before the store
+        // (store buffering), which would strand that work.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (head_.load(std::memory_order_acquire) == nullptr)
+          co_return;
+
+        if (scheduled_.exchange(true, std::memory_order_acq_rel))
+          co_return;
+      }
+    }
+  } // namespace detail
+
+  bool Executor::running_in_this_thread() const noexcept
+  {
+    return sched_ && static_cast<const detail::Scheduler *>(sched_)->running_in_this_thread();
+  }
+
+  void Executor::submit(detail::WorkItem *work)
+  {
+    if (!sched_)
+    {
+      work->complete(work, false);
+      return;
+    }
+
+    static_cast<detail::Scheduler *>(sched_)->submit(work);
+  }
+
+} // namespace vix::net_corosio
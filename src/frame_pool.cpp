@@ -0,0 +1,149 @@
+#include "detail/frame_pool.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace vix::net_corosio::detail
+{
+  namespace
+  {
+    struct FreeBlock
+    {
+      FreeBlock *next;
+    };
+
+    /**
+     * @brief Per-thread free lists, one per size class.
+     */
+    struct FrameCache final
+    {
+      std::array<FreeBlock *, FramePool::classes> heads{};
+      std::array<std::uint32_t, FramePool::classes> counts{};
+
+      FrameCache() noexcept;
+      ~FrameCache();
+    };
+
+    // Cleared when the cache is destroyed at thread exit, so frames released
+    // by later thread_local destructors bypass it.
+    thread_local bool tls_cache_alive = false;
+
+    FrameCache::FrameCache() noexcept
+    {
+      tls_cache_alive = true;
+    }
+
+    FrameCache::~FrameCache()
+    {
+      tls_cache_alive = false;
+
+      for (std::size_t c = 0; c < FramePool::classes; ++c)
+      {
+        FreeBlock *b = heads[c];
+        while (b)
+        {
+          FreeBlock *next = b->next;
+          ::operator delete(static_cast<void *>(b));
+          b = next;
+        }
+        heads[c] = nullptr;
+        counts[c] = 0;
+      }
+    }
+
+    FrameCache *this_thread_cache() noexcept
+    {
+      thread_local FrameCache cache;
+      return tls_cache_alive ? &cache : nullptr;
+    }
+
+    constexpr bool pooled(std::size_t bytes, std::size_t alignment) noexcept
+    {
+      return bytes <= FramePool::max_block &&
+             alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    }
+
+    constexpr std::size_t class_of(std::size_t bytes) noexcept
+    {
+      if (bytes <= FramePool::min_block)
+        return 0;
+
+      // 65..128 -> 1, 129..256 -> 2, ...
+      return static_cast<std::size_t>(std::bit_width(bytes - 1)) - 6;
+    }
+
+    constexpr std::size_t block_size(std::size_t cls) noexcept
+    {
+      return FramePool::min_block << cls;
+    }
+  } // namespace
+
+  void *FramePool::do_allocate(std::size_t bytes, std::size_t alignment)
+  {
+    if (!pooled(bytes, alignment))
+    {
+      if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        return ::operator new(bytes, std::align_val_t{alignment});
+
+      return ::operator new(bytes);
+    }
+
+    const std::size_t cls = class_of(bytes);
+
+    if (FrameCache *cache = this_thread_cache())
+    {
+      if (FreeBlock *b = cache->heads[cls])
+      {
+        cache->heads[cls] = b->next;
+        --cache->counts[cls];
+        return static_cast<void *>(b);
+      }
+    }
+
+    return ::operator new(block_size(cls));
+  }
+
+  void FramePool::do_deallocate(void *p, std::size_t bytes, std::size_t alignment)
+  {
+    if (!p)
+      return;
+
+    if (!pooled(bytes, alignment))
+    {
+      if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        ::operator delete(p, std::align_val_t{alignment});
+      else
+        ::operator delete(p);
+      return;
+    }
+
+    const std::size_t cls = class_of(bytes);
+
+    FrameCache *cache = this_thread_cache();
+    if (!cache || cache->counts[cls] >= max_cached)
+    {
+      ::operator delete(p);
+      return;
+    }
+
+    auto *b = static_cast<FreeBlock *>(p);
+    b->next = cache->heads[cls];
+    cache->heads[cls] = b;
+    ++cache->counts[cls];
+  }
+
+  bool FramePool::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+  {
+    return this == &other;
+  }
+
+  FramePool &frame_pool() noexcept
+  {
+    static FramePool pool;
+    return pool;
+  }
+
+} // namespace vix::net_corosio::detail
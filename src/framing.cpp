@@ -0,0 +1,128 @@
+#include <vix/net_corosio/framing.hpp>
+
+#include <cstring>
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#include <emmintrin.h>
+#define VIX_NET_COROSIO_FIND_SSE2 1
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define VIX_NET_COROSIO_FIND_AVX2 1
+#endif
+
+namespace vix::net_corosio::detail
+{
+  namespace
+  {
+    using find_fn = std::size_t (*)(const char *, std::size_t, const char *, std::size_t) noexcept;
+
+    constexpr std::size_t npos = std::string_view::npos;
+
+    // Candidate at i: first and last needle bytes already matched.
+    inline bool matches_at(const char *hay, std::size_t i, const char *needle, std::size_t m) noexcept
+    {
+      return m <= 2 || std::memcmp(hay + i + 1, needle + 1, m - 2) == 0;
+    }
+
+    std::size_t find_scalar(const char *hay, std::size_t n, const char *needle, std::size_t m) noexcept
+    {
+      if (m == 1)
+      {
+        const void *p = std::memchr(hay, needle[0], n);
+        return p ? static_cast<std::size_t>(static_cast<const char *>(p) - hay) : npos;
+      }
+
+      for (std::size_t i = 0; i + m <= n; ++i)
+      {
+        if (hay[i] == needle[0] && hay[i + m - 1] == needle[m - 1] && matches_at(hay, i, needle, m))
+          return i;
+      }
+      return npos;
+    }
+
+#ifdef VIX_NET_COROSIO_FIND_SSE2
+    std::size_t find_sse2(const char *hay, std::size_t n, const char *needle, std::size_t m) noexcept
+    {
+      const __m128i first = _mm_set1_epi8(needle[0]);
+      const __m128i last = _mm_set1_epi8(needle[m - 1]);
+
+      std::size_t i = 0;
+      for (; i + m - 1 + 16 <= n; i += 16)
+      {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay + i + m - 1));
+
+        auto mask = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+
+        while (mask != 0)
+        {
+          const auto bit = static_cast<std::size_t>(__builtin_ctz(mask));
+          if (matches_at(hay, i + bit, needle, m))
+            return i + bit;
+          mask &= mask - 1;
+        }
+      }
+
+      const std::size_t rest = find_scalar(hay + i, n - i, needle, m);
+      return rest == npos ? npos : i + rest;
+    }
+#endif
+
+#ifdef VIX_NET_COROSIO_FIND_AVX2
+    __attribute__((target("avx2")))
+    std::size_t find_avx2(const char *hay, std::size_t n, const char *needle, std::size_t m) noexcept
+    {
+      const __m256i first = _mm256_set1_epi8(needle[0]);
+      const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+
+      std::size_t i = 0;
+      for (; i + m - 1 + 32 <= n; i += 32)
+      {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(hay + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(hay + i + m - 1));
+
+        auto mask = static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+
+        while (mask != 0)
+        {
+          const auto bit = static_cast<std::size_t>(__builtin_ctz(mask));
+          if (matches_at(hay, i + bit, needle, m))
+            return i + bit;
+          mask &= mask - 1;
+        }
+      }
+
+      const std::size_t rest = find_scalar(hay + i, n - i, needle, m);
+      return rest == npos ? npos : i + rest;
+    }
+#endif
+
+    find_fn pick() noexcept
+    {
+#ifdef VIX_NET_COROSIO_FIND_AVX2
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+        return &find_avx2;
+#endif
+#ifdef VIX_NET_COROSIO_FIND_SSE2
+      return &find_sse2;
+#else
+      return &find_scalar;
+#endif
+    }
+  } // namespace
+
+  std::size_t find_delimiter(std::string_view haystack, std::string_view needle) noexcept
+  {
+    if (needle.empty() || needle.size() > haystack.size())
+      return needle.empty() ? 0 : npos;
+
+    static const find_fn find = pick();
+    return find(haystack.data(), haystack.size(), needle.data(), needle.size());
+  }
+
+} // namespace vix::net_corosio::detail
@@ -0,0 +1,317 @@
+#include <vix/net_corosio/socket.hpp>
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/resolver.hpp>
+#include <vix/net_corosio/timer.hpp>
+
+#include <boost/corosio.hpp>
+#include <boost/capy/task.hpp>
+
+#include "detail/composed.hpp"
+#include "detail/deadline_guard.hpp"
+#include "detail/frame_pool.hpp"
+#include "detail/run_blocking.hpp"
+#include "detail/waiter.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+
+namespace vix::net_corosio
+{
+  namespace
+  {
+    /**
+     * @brief RFC 8305 section 4: alternate address families, starting with
+     * the family the resolver preferred, keeping its order within each.
+     */
+    std::vector<TcpEndpoint> interleave(const std::vector<Endpoint> &endpoints)
+    {
+      std::vector<const Endpoint *> first;
+      std::vector<const Endpoint *> second;
+
+      const IpVersion preferred = endpoints.front().ip;
+      for (const Endpoint &ep : endpoints)
+        (ep.ip == preferred ? first : second).push_back(&ep);
+
+      std::vector<TcpEndpoint> out;
+      out.reserve(endpoints.size());
+
+      for (std::size_t i = 0; i < first.size() || i < second.size(); ++i)
+      {
+        if (i < first.size())
+          out.push_back(TcpEndpoint{first[i]->address, first[i]->port});
+        if (i < second.size())
+          out.push_back(TcpEndpoint{second[i]->address, second[i]->port});
+      }
+
+      return out;
+    }
+
+    /**
+     * @brief State shared by connect_any() and the attempts and pacing
+     * timers it started.
+     *
+     * Kept alive by those tasks, which may finish on other loop threads.
+     */
+    struct Race final
+    {
+      Context *ctx{nullptr};
+      std::vector<TcpEndpoint> targets;
+      std::vector<Socket> attempts; // one per target, never reallocated
+      Deadline deadline{};
+
+      std::mutex mu{};
+      std::size_t connecting{0};
+      std::size_t pacing{0};
+      std::optional<std::size_t> winner{};
+      Error last{ErrorCode::connect_failed};
+
+      // The pacing timer of the latest start; fired once it expired.
+      std::size_t started{0};
+      Timer *pacer{nullptr};
+      bool fired{false};
+      bool done{false};
+
+      detail::Waiter wake{};
+
+      void cancel_pacer() noexcept
+      {
+        if (pacer)
+          pacer->cancel();
+        pacer = nullptr;
+      }
+    };
+
+    capy::task<void> run_attempt(std::shared_ptr<Race> race, std::size_t i)
+    {
+      Error e{ErrorCode::unknown};
+
+      try
+      {
+        e = co_await race->attempts[i].async_connect(race->targets[i], race->deadline);
+      }
+      catch (...)
+      {
+        e = Error{ErrorCode::unknown};
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(race->mu);
+        --race->connecting;
+
+        if (e)
+          race->last = e;
+        else if (!race->winner)
+          race->winner = i;
+        else
+          race->attempts[i].close(); // connected after the race was decided
+      }
+
+      race->wake.wake();
+    }
+
+    capy::task<void> run_pacer(std::shared_ptr<Race> race, std::size_t round, Timer::time_point at)
+    {
+      Timer t(*race->ctx);
+      t.expires_at(at);
+
+      bool armed = false;
+      {
+        std::lock_guard<std::mutex> lock(race->mu);
+        // A later start may already have superseded this pacer.
+        if (!race->done && race->started == round)
+        {
+          race->pacer = &t;
+          armed = true;
+        }
+      }
+
+      Error e{ErrorCode::canceled};
+      if (armed)
+      {
+        try
+        {
+          e = co_await t.async_wait();
+        }
+        catch (...)
+        {
+          e = Error{ErrorCode::unknown};
+        }
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(race->mu);
+
+        // A replaced or cancelled pacer only wakes the race.
+        if (race->pacer == &t)
+        {
+          race->pacer = nullptr;
+          race->fired = !e;
+        }
+
+        --race->pacing;
+      }
+
+      race->wake.wake();
+    }
+  } // namespace
+
+  Error Socket::connect_any(const ResolveResult &resolved, Deadline deadline)
+  {
+    if (!impl_ || !context())
+      return Error{ErrorCode::not_initialized};
+
+    return detail::run_blocking(*context(), [&]
+                                { return async_connect_any(resolved, deadline); });
+  }
+
+  Error Socket::connect(std::string_view host, std::string_view service, Deadline deadline)
+  {
+    if (!impl_ || !context())
+      return Error{ErrorCode::not_initialized};
+
+    return detail::run_blocking(*context(), [&]
+                                { return async_connect(std::string(host), std::string(service), deadline); });
+  }
+
+  Task<Error> Socket::async_connect_any(ResolveResult resolved, Deadline deadline)
+  {
+    Context *ctx = context();
+    if (!ctx)
+      co_return Error{ErrorCode::not_initialized};
+
+    if (!resolved.ok())
+      co_return resolved.error;
+
+    if (resolved.endpoints.empty())
+      co_return Error{ErrorCode::invalid_argument};
+
+    if (state() == SocketState::connected)
+      co_return Error{ErrorCode::invalid_state};
+
+    auto race = std::make_shared<Race>();
+
+    try
+    {
+      race->ctx = ctx;
+      race->targets = interleave(resolved.endpoints);
+      race->deadline = detail::composed_deadline(deadline, timeout());
+
+      // Attempts inherit this socket's settings; the winner replaces it.
+      race->attempts.reserve(race->targets.size());
+      for (std::size_t i = 0; i < race->targets.size(); ++i)
+      {
+        Socket &s = race->attempts.emplace_back(*ctx);
+        (void)s.set_options(options());
+        s.set_timeout(timeout());
+      }
+    }
+    catch (...)
+    {
+      co_return Error{ErrorCode::unknown};
+    }
+
+    auto &ioc = *static_cast<corosio::io_context *>(ctx->native_handle());
+    const auto delay = ctx->config().connect_attempt_delay;
+    const std::size_t n = race->targets.size();
+    std::size_t next = 0;
+
+    for (;;)
+    {
+      bool start = false;
+      {
+        std::lock_guard<std::mutex> lock(race->mu);
+
+        if (race->winner || (next == n && race->connecting == 0))
+          break;
+
+        // Start the next address when the pacing delay expired or nothing
+        // is left in flight (the previous attempt failed early).
+        if (next < n && (race->connecting == 0 || race->fired))
+        {
+          start = true;
+          race->fired = false;
+          race->cancel_pacer();
+          ++race->started;
+          ++race->connecting;
+
+          if (next + 1 < n)
+            ++race->pacing;
+        }
+      }
+
+      if (!start)
+      {
+        co_await race->wake.wait();
+        continue;
+      }
+
+      const std::size_t i = next++;
+      detail::launcher(ioc.get_executor())(run_attempt(race, i));
+
+      if (next < n)
+        detail::launcher(ioc.get_executor())(run_pacer(race, next, Timer::clock::now() + delay));
+    }
+
+    // Cancel the losers and wait for every task to let go of the race.
+    {
+      std::lock_guard<std::mutex> lock(race->mu);
+      race->done = true;
+      race->cancel_pacer();
+
+      for (std::size_t i = 0; i < next; ++i)
+      {
+        if (!race->winner || i != *race->winner)
+          detail::cancel_io<corosio::tcp_socket>(race->attempts[i].native_handle());
+      }
+    }
+
+    for (;;)
+    {
+      {
+        std::lock_guard<std::mutex> lock(race->mu);
+        if (race->connecting == 0 && race->pacing == 0)
+          break;
+      }
+
+      co_await race->wake.wait();
+    }
+
+    if (!race->winner)
+      co_return race->last;
+
+    const auto keep_timeout = timeout();
+    const bool keep_zero_copy = zero_copy();
+
+    // Replaces impl_ wholesale; hence TlsStream must be created afterwards.
+    *this = std::move(race->attempts[*race->winner]);
+
+    set_timeout(keep_timeout);
+    if (keep_zero_copy)
+      (void)set_zero_copy(true);
+
+    co_return Error{ErrorCode::none};
+  }
+
+  Task<Error> Socket::async_connect(std::string host, std::string service, Deadline deadline)
+  {
+    Context *ctx = context();
+    if (!ctx)
+      co_return Error{ErrorCode::not_initialized};
+
+    Resolver resolver(*ctx);
+    auto resolved = co_await resolver.async_resolve(std::move(host), std::move(service));
+
+    co_return co_await async_connect_any(std::move(resolved), deadline);
+  }
+
+} // namespace vix::net_corosio
@@ -1,12 +1,24 @@
 #include <vix/net_corosio/listener.hpp>
 #include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/timer.hpp>
 
 #include <boost/corosio.hpp>
-#include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/task.hpp>
 
+#include "detail/endpoint.hpp"
+#include "detail/frame_pool.hpp"
+#include "detail/native.hpp"
+#include "detail/run_blocking.hpp"
+#include "detail/socket_options.hpp"
+#include "detail/waiter.hpp"
+
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <exception>
+#include <memory>
+#include <optional>
+#include <string>
 #include <system_error>
 #include <utility>
 
@@ -41,12 +53,56 @@ namespace vix::net_corosio
     corosio::tcp_acceptor acc;
     ListenerState st{ListenerState::closed};
 
+    // Inherited by accepted sockets.
+    SocketOptions opts;
+
+    bool v6{false};
+    bool bound{false};
+
+    // Replayed when bind() reopens the acceptor for another family.
+    std::optional<bool> reuse_port;
+    std::optional<bool> v6_only;
+    int fast_open{0};
+
     explicit Impl(Context &c)
         : ctx(&c),
           ioc(static_cast<corosio::io_context *>(c.native_handle())),
           acc(*ioc)
     {
     }
+
+    // async_accept() that also reports the backend error, for serve().
+    Task<AcceptResult> accept(std::error_code &ec);
+
+    Error open_family(bool ipv6)
+    {
+      const Error e = detail::open_for(acc, ipv6);
+      if (e)
+        return e;
+
+      st = ListenerState::open;
+      v6 = ipv6;
+      bound = false;
+
+      const int fd = detail::native_fd(acc);
+
+      // Best effort, as for Socket::open().
+      if (!opts.empty())
+        (void)detail::apply_options(fd, opts);
+
+#if defined(SO_REUSEPORT)
+      if (reuse_port)
+        (void)detail::set_int_option(fd, SOL_SOCKET, SO_REUSEPORT, *reuse_port ? 1 : 0);
+#endif
+
+      if (ipv6 && v6_only)
+        (void)detail::set_v6_only(fd, *v6_only);
+
+      if (fast_open > 0)
+        (void)detail::set_fast_open(fd, fast_open);
+
+      return Error{ErrorCode::none};
+    }
   };
 
   Listener::Listener(Context &ctx)
@@ -96,23 +152,106 @@ namespace vix::net_corosio
 
     try
     {
-      impl_->acc.open();
-      impl_->st = ListenerState::open;
-      return Error{ErrorCode::none};
+      return impl_->open_family(false);
+    }
+    catch (...)
+    {
+      return Error{ErrorCode::unknown};
+    }
+  }
+
+  Error Listener::set_reuse_port(bool enabled)
+  {
+    if (!impl_ || !impl_->ioc)
+      return Error{ErrorCode::not_initialized};
+
+    if (impl_->st != ListenerState::open)
+      return Error{ErrorCode::invalid_state};
+
+#if defined(SO_REUSEPORT)
+    impl_->reuse_port = enabled;
+    return detail::set_int_option(detail::native_fd(impl_->acc), SOL_SOCKET, SO_REUSEPORT, enabled ? 1 : 0);
+#else
+    (void)enabled;
+    return Error{ErrorCode::not_supported};
+#endif
+  }
+
+  Error Listener::set_v6_only(bool enabled)
+  {
+    if (!impl_ || !impl_->ioc)
+      return Error{ErrorCode::not_initialized};
+
+    if (impl_->bound)
+      return Error{ErrorCode::invalid_state};
+
+    impl_->v6_only = enabled;
+
+    // Applied by bind() once the listener is open for IPv6.
+    if (impl_->st == ListenerState::open && impl_->v6)
+      return detail::set_v6_only(detail::native_fd(impl_->acc), enabled);
+
+    return Error{ErrorCode::none};
+  }
+
+  Error Listener::set_fast_open(int queue_length)
+  {
+    if (!impl_ || !impl_->ioc)
+      return Error{ErrorCode::not_initialized};
+
+    if (queue_length <= 0)
+      return Error{ErrorCode::invalid_argument};
+
+    if (impl_->st != ListenerState::open)
+      return Error{ErrorCode::invalid_state};
+
+    impl_->fast_open = queue_length;
+    return detail::set_fast_open(detail::native_fd(impl_->acc), queue_length);
+  }
+
+  Error Listener::set_options(const SocketOptions &opts)
+  {
+    if (!impl_ || !impl_->ioc)
+      return Error{ErrorCode::not_initialized};
+
+    try
+    {
+      impl_->opts.merge(opts);
     }
     catch (...)
     {
       return Error{ErrorCode::unknown};
     }
+
+    if (impl_->st == ListenerState::closed)
+      return Error{ErrorCode::none};
+
+    return detail::apply_options(detail::native_fd(impl_->acc), opts);
   }
 
   Error Listener::bind(std::uint16_t port)
+  {
+    return bind(TcpEndpoint{std::string{}, port});
+  }
+
+  Error Listener::bind(const TcpEndpoint &ep)
   {
     if (!impl_ || !impl_->ioc || !impl_->ctx)
       return Error{ErrorCode::not_initialized};
 
+    corosio::endpoint local{};
+    if (!detail::parse_address(ep.address, ep.port, true, local))
+      return Error{ErrorCode::invalid_argument};
+
+    if (impl_->bound || impl_->st == ListenerState::listening)
+      return Error{ErrorCode::invalid_state};
+
+    const bool v6 = !local.is_v4();
     const bool strict = impl_->ctx->config().strict_checks;
 
+    if (v6 && !detail::has_family_open<corosio::tcp_acceptor>)
+      return Error{ErrorCode::not_supported};
+
     if (strict && impl_->st == ListenerState::closed)
     {
       auto e = open();
@@ -124,15 +263,24 @@ namespace vix::net_corosio
       (void)open();
     }
 
-    if (port == 0)
-      return Error{ErrorCode::invalid_argument};
-
     try
     {
-      auto ec = impl_->acc.bind(corosio::endpoint(port));
+      // open() defaults to IPv4; settings made since are replayed.
+      if (impl_->st == ListenerState::open && impl_->v6 != v6)
+      {
+        impl_->acc.close();
+        impl_->st = ListenerState::closed;
+
+        const Error e = impl_->open_family(v6);
+        if (e)
+          return e;
+      }
+
+      auto ec = impl_->acc.bind(local);
       if (ec)
         return Error{ErrorCode::accept_failed};
 
+      impl_->bound = true;
       return Error{ErrorCode::none};
     }
     catch (...)
@@ -141,6 +289,14 @@ namespace vix::net_corosio
     }
   }
 
+  TcpEndpoint Listener::local_endpoint() const
+  {
+    if (!impl_ || !impl_->bound)
+      return TcpEndpoint{};
+
+    return detail::endpoint_of(detail::native_fd(impl_->acc), true);
+  }
+
   Error Listener::listen(int backlog)
   {
     if (!impl_ || !impl_->ioc || !impl_->ctx)
@@ -176,61 +332,195 @@ namespace vix::net_corosio
       std::terminate();
     }
 
-    AcceptResult out(*impl_->ctx);
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_accept(); });
+  }
+
+  Task<Listener::AcceptResult> Listener::async_accept()
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+    {
+      std::terminate();
+    }
+
+    std::error_code ec;
+    co_return co_await impl_->accept(ec);
+  }
+
+  Task<Listener::AcceptResult> Listener::Impl::accept(std::error_code &ec)
+  {
+    AcceptResult out(*ctx);
     out.error = Error{ErrorCode::unknown};
     out.socket.close();
 
-    const bool strict = impl_->ctx->config().strict_checks;
-    if (strict && impl_->st != ListenerState::listening)
+    const bool strict = ctx->config().strict_checks;
+    if (strict && st != ListenerState::listening)
     {
       out.error = Error{ErrorCode::invalid_state};
-      return out;
+      co_return out;
     }
 
     auto *native_sock = static_cast<corosio::tcp_socket *>(out.socket.native_handle());
     if (!native_sock)
     {
       out.error = Error{ErrorCode::not_initialized};
-      return out;
+      co_return out;
     }
 
-    std::atomic<bool> done{false};
+    try
+    {
+      auto r = co_await acc.accept(*native_sock);
+      ec = detail::io_error(r);
 
-    auto task = [&]() -> capy::task<void>
+      out.error = ec ? Error{ErrorCode::accept_failed} : Error{ErrorCode::none};
+    }
+    catch (...)
     {
-      try
+      out.error = Error{ErrorCode::unknown};
+    }
+
+    if (out.error)
+    {
+      out.socket.close();
+    }
+    else
+    {
+      out.socket.mark_connected();
+
+      if (!opts.empty())
+        (void)out.socket.set_options(opts);
+    }
+
+    co_return out;
+  }
+
+  namespace
+  {
+    /**
+     * @brief State shared by a serve() loop and the handlers it started.
+     *
+     * Kept alive by the handlers so it survives the loop returning first.
+     */
+    struct ServeState final
+    {
+      Listener::ConnectionHandler handler;
+      std::size_t limit{0};
+      std::atomic<std::size_t> in_flight{0};
+      detail::Waiter slot_free{};
+
+      bool saturated() const noexcept
       {
-        auto r = co_await impl_->acc.accept(*native_sock);
-        const auto ec = detail::io_error(r);
+        return limit != 0 && in_flight.load(std::memory_order_acquire) >= limit;
+      }
+    };
 
-        if (ec)
-        {
-          out.error = Error{ErrorCode::accept_failed};
-          done.store(true, std::memory_order_release);
-          co_return;
-        }
+    enum class AcceptRetry
+    {
+      no,    // listener broken: stop serving
+      now,   // this connection failed: accept the next one
+      later, // out of descriptors, memory or network: back off first
+    };
 
-        out.error = Error{ErrorCode::none};
+    // Linux accept(2) also reports errors of the pending connection, which
+    // must not end the loop; see its man page.
+    AcceptRetry classify_accept_error(const std::error_code &ec) noexcept
+    {
+      if (ec == std::errc::too_many_files_open ||
+          ec == std::errc::too_many_files_open_in_system ||
+          ec == std::errc::no_buffer_space ||
+          ec == std::errc::not_enough_memory ||
+          ec == std::errc::network_down ||
+          ec == std::errc::network_unreachable ||
+          ec == std::errc::host_unreachable)
+        return AcceptRetry::later;
+
+      if (ec == std::errc::connection_aborted ||
+          ec == std::errc::connection_reset ||
+          ec == std::errc::protocol_error ||
+          ec == std::errc::no_protocol_option ||
+          ec == std::errc::operation_not_permitted ||
+          ec == std::errc::interrupted ||
+          ec == std::errc::resource_unavailable_try_again ||
+          ec == std::errc::operation_would_block ||
+          ec == std::errc::timed_out)
+        return AcceptRetry::now;
+
+      return AcceptRetry::no;
+    }
+
+    capy::task<void> run_handler(std::shared_ptr<ServeState> state, Socket sock)
+    {
+      try
+      {
+        co_await state->handler(std::move(sock));
       }
       catch (...)
       {
-        out.error = Error{ErrorCode::unknown};
+        // A failing handler only ends its own connection.
       }
 
-      done.store(true, std::memory_order_release);
-    };
+      state->in_flight.fetch_sub(1, std::memory_order_acq_rel);
+      state->slot_free.wake();
+    }
+  } // namespace
+
+  Task<Error> Listener::serve(ConnectionHandler handler, std::size_t max_in_flight)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      co_return Error{ErrorCode::not_initialized};
 
-    capy::run_async(impl_->ioc->get_executor())(task());
+    if (!handler)
+      co_return Error{ErrorCode::invalid_argument};
 
-    while (!done.load(std::memory_order_acquire))
+    auto state = std::make_shared<ServeState>();
+    state->handler = std::move(handler);
+    state->limit = max_in_flight != 0 ? max_in_flight : impl_->ctx->config().max_workers;
+
+    constexpr std::chrono::milliseconds backoff_min{5};
+    constexpr std::chrono::milliseconds backoff_max{1000};
+
+    std::optional<Timer> backoff;
+    std::chrono::milliseconds delay{0};
+
+    for (;;)
     {
-      impl_->ioc->run_one();
-    }
+      while (state->saturated())
+        co_await state->slot_free.wait();
 
-    if (out.error)
-      out.socket.close();
+      std::error_code ec;
+      auto accepted = co_await impl_->accept(ec);
+
+      if (!accepted.ok())
+      {
+        // close() from another task ends the loop cleanly.
+        if (!impl_ || impl_->st == ListenerState::closed)
+          co_return Error{ErrorCode::none};
+
+        const AcceptRetry retry = ec ? classify_accept_error(ec) : AcceptRetry::no;
+        if (retry == AcceptRetry::no)
+          co_return accepted.error;
 
-    return out;
+        if (retry == AcceptRetry::later)
+        {
+          // Handlers finishing free descriptors; an immediate retry would spin.
+          delay = std::clamp(delay * 2, backoff_min, backoff_max);
+
+          if (!backoff)
+            backoff.emplace(*impl_->ctx);
+
+          backoff->expires_after(delay);
+          (void)co_await backoff->async_wait();
+        }
+
+        continue;
+      }
+
+      delay = std::chrono::milliseconds{0};
+
+      state->in_flight.fetch_add(1, std::memory_order_acq_rel);
+      detail::launcher(impl_->ioc->get_executor())(
+          run_handler(state, std::move(accepted.socket)));
+    }
   }
 
   void Listener::close() noexcept
@@ -247,6 +537,7 @@ namespace vix::net_corosio
     }
 
     impl_->st = ListenerState::closed;
+    impl_->bound = false;
   }
 
   void *Listener::native_handle() noexcept
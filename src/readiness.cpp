@@ -0,0 +1,378 @@
+#include "detail/readiness.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace vix::net_corosio::detail
+{
+  namespace
+  {
+    // epoll tag of the shutdown eventfd; fds are tagged (gen << 32) | fd.
+    constexpr std::uint64_t wake_tag = ~std::uint64_t{0};
+
+    constexpr std::uint64_t tag_of(std::uint32_t gen, int fd) noexcept
+    {
+      return (std::uint64_t{gen} << 32) | static_cast<std::uint32_t>(fd);
+    }
+  } // namespace
+
+  ReadinessService::ReadinessService(TimerService &timers) noexcept
+      : timers_(timers)
+  {
+    // Never due in practice: the entry only keeps the loop alive.
+    keepalive_.fire = [](TimerNode *) noexcept {};
+    keepalive_.user = this;
+  }
+
+  ReadinessService::~ReadinessService()
+  {
+#if defined(__linux__)
+    if (thread_.joinable())
+    {
+      stopping_.store(true, std::memory_order_release);
+
+      const std::uint64_t one = 1;
+      (void)::write(wakefd_, &one, sizeof(one));
+      thread_.join();
+    }
+
+    if (wakefd_ >= 0)
+      ::close(wakefd_);
+    if (epfd_ >= 0)
+      ::close(epfd_);
+#endif
+
+    if (parked_ != 0)
+      (void)timers_.cancel(keepalive_);
+  }
+
+  void ReadinessService::complete(ReadyWait &w, Error e) noexcept
+  {
+    w.result = e;
+    std::coroutine_handle<> h = std::exchange(w.waiter, std::coroutine_handle<>{});
+
+    if (!h)
+      return;
+
+    // Last touch of w: the waiter may destroy it as soon as it runs.
+    try
+    {
+      w.ex.post([h]
+                { h.resume(); });
+    }
+    catch (...)
+    {
+      h.resume();
+    }
+  }
+
+  void ReadinessService::cancel_wait(void *w) noexcept
+  {
+    auto *wait = static_cast<ReadyWait *>(w);
+    if (wait->svc)
+      (void)wait->svc->cancel(*wait);
+  }
+
+  void ReadinessService::released_locked(std::size_t n) noexcept
+  {
+    parked_ -= n;
+    if (n != 0 && parked_ == 0)
+      (void)timers_.cancel(keepalive_);
+  }
+
+#if defined(__linux__)
+
+  bool ReadinessService::start_locked() noexcept
+  {
+    if (epfd_ >= 0)
+      return true;
+
+    const int ep = ::epoll_create1(EPOLL_CLOEXEC);
+    if (ep < 0)
+      return false;
+
+    const int wake = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wake < 0)
+    {
+      ::close(ep);
+      return false;
+    }
+
+    ::epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = wake_tag;
+
+    if (::epoll_ctl(ep, EPOLL_CTL_ADD, wake, &ev) != 0)
+    {
+      ::close(wake);
+      ::close(ep);
+      return false;
+    }
+
+    try
+    {
+      epfd_ = ep;
+      wakefd_ = wake;
+      thread_ = std::thread([this]
+                            { run(); });
+    }
+    catch (...)
+    {
+      epfd_ = -1;
+      wakefd_ = -1;
+      ::close(wake);
+      ::close(ep);
+      return false;
+    }
+
+    return true;
+  }
+
+  bool ReadinessService::update_locked(int fd, Entry &e, bool added) noexcept
+  {
+    std::uint32_t events = 0;
+    if (e.reader)
+      events |= EPOLLIN | EPOLLRDHUP;
+    if (e.writer)
+      events |= EPOLLOUT;
+
+    if (events == 0)
+    {
+      (void)::epoll_ctl(epfd_, EPOLL_CTL_DEL, fd, nullptr);
+      fds_.erase(fd);
+      return true;
+    }
+
+    ::epoll_event ev{};
+    ev.events = events | EPOLLONESHOT;
+    ev.data.u64 = tag_of(e.gen, fd);
+
+    if (::epoll_ctl(epfd_, added ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &ev) == 0)
+      return true;
+
+    // Closed behind our back (epoll dropped it), and the number reused.
+    if (!added && errno == ENOENT)
+      return ::epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) == 0;
+
+    return false;
+  }
+
+  bool ReadinessService::park(ReadyWait &w, std::coroutine_handle<> h) noexcept
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+
+    if (w.canceled)
+    {
+      w.result = Error{ErrorCode::canceled};
+      return false;
+    }
+
+    if (w.fd < 0 || !start_locked())
+    {
+      w.result = Error{w.fd < 0 ? ErrorCode::invalid_state : ErrorCode::unknown};
+      return false;
+    }
+
+    try
+    {
+      auto [it, added] = fds_.try_emplace(w.fd);
+      Entry &e = it->second;
+      if (added)
+        e.gen = ++next_gen_;
+
+      ReadyWait *&slot = w.write ? e.writer : e.reader;
+      if (slot)
+      {
+        w.result = Error{ErrorCode::invalid_state};
+        return false;
+      }
+
+      slot = &w;
+      w.svc = this;
+      w.waiter = h;
+
+      if (!update_locked(w.fd, e, added))
+      {
+        slot = nullptr;
+        w.waiter = {};
+        (void)update_locked(w.fd, e, false);
+        w.result = Error{ErrorCode::unknown};
+        return false;
+      }
+
+      if (parked_++ == 0)
+        timers_.schedule(keepalive_, TimerService::clock::time_point::max());
+    }
+    catch (...)
+    {
+      w.result = Error{ErrorCode::unknown};
+      return false;
+    }
+
+    return true;
+  }
+
+  bool ReadinessService::cancel(ReadyWait &w) noexcept
+  {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+
+      // Not parked yet: park() completes it at once.
+      w.canceled = true;
+
+      auto it = fds_.find(w.fd);
+      if (it == fds_.end())
+        return false;
+
+      Entry &e = it->second;
+      ReadyWait *&slot = w.write ? e.writer : e.reader;
+      if (slot != &w)
+        return false;
+
+      slot = nullptr;
+      (void)update_locked(w.fd, e, false);
+      released_locked(1);
+    }
+
+    complete(w, Error{ErrorCode::canceled});
+    return true;
+  }
+
+  void ReadinessService::cancel_fd(int fd) noexcept
+  {
+    ReadyWait *taken[2] = {nullptr, nullptr};
+
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+
+      auto it = fds_.find(fd);
+      if (it == fds_.end())
+        return;
+
+      taken[0] = std::exchange(it->second.reader, nullptr);
+      taken[1] = std::exchange(it->second.writer, nullptr);
+      (void)update_locked(fd, it->second, false);
+      released_locked((taken[0] ? 1 : 0) + (taken[1] ? 1 : 0));
+    }
+
+    for (ReadyWait *w : taken)
+    {
+      if (w)
+        complete(*w, Error{ErrorCode::canceled});
+    }
+  }
+
+  void ReadinessService::run() noexcept
+  {
+    constexpr int batch = 64;
+
+    struct Done final
+    {
+      ReadyWait *w;
+      Error e;
+    };
+
+    std::array<::epoll_event, batch> events{};
+    std::array<Done, 2 * batch> done{};
+
+    while (!stopping_.load(std::memory_order_acquire))
+    {
+      const int n = ::epoll_wait(epfd_, events.data(), batch, -1);
+      if (n < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        return;
+      }
+
+      std::size_t count = 0;
+
+      {
+        std::lock_guard<std::mutex> lock(mu_);
+
+        for (int i = 0; i < n; ++i)
+        {
+          const std::uint64_t tag = events[i].data.u64;
+          if (tag == wake_tag)
+            continue;
+
+          const int fd = static_cast<int>(static_cast<std::uint32_t>(tag));
+          auto it = fds_.find(fd);
+
+          // Stale event for a wait that was cancelled (and maybe replaced).
+          if (it == fds_.end() || it->second.gen != static_cast<std::uint32_t>(tag >> 32))
+            continue;
+
+          Entry &e = it->second;
+          const std::uint32_t ev = events[i].events;
+
+          if (e.reader && (ev & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)))
+            done[count++] = Done{std::exchange(e.reader, nullptr), Error{ErrorCode::none}};
+
+          if (e.writer && (ev & (EPOLLOUT | EPOLLHUP | EPOLLERR)))
+            done[count++] = Done{std::exchange(e.writer, nullptr), Error{ErrorCode::none}};
+
+          // One-shot: re-arm for the direction still waiting, or drop the fd.
+          if (!update_locked(fd, e, false))
+          {
+            if (e.reader)
+              done[count++] = Done{std::exchange(e.reader, nullptr), Error{ErrorCode::unknown}};
+            if (e.writer)
+              done[count++] = Done{std::exchange(e.writer, nullptr), Error{ErrorCode::unknown}};
+            (void)update_locked(fd, e, false);
+          }
+        }
+
+        released_locked(count);
+      }
+
+      for (std::size_t i = 0; i < count; ++i)
+        complete(*done[i].w, done[i].e);
+    }
+  }
+
+#else
+
+  bool ReadinessService::start_locked() noexcept
+  {
+    return false;
+  }
+
+  bool ReadinessService::update_locked(int, Entry &, bool) noexcept
+  {
+    return false;
+  }
+
+  bool ReadinessService::park(ReadyWait &w, std::coroutine_handle<>) noexcept
+  {
+    w.result = Error{ErrorCode::not_supported};
+    return false;
+  }
+
+  bool ReadinessService::cancel(ReadyWait &) noexcept
+  {
+    return false;
+  }
+
+  void ReadinessService::cancel_fd(int) noexcept
+  {
+  }
+
+  void ReadinessService::run() noexcept
+  {
+  }
+
+#endif
+
+} // namespace vix::net_corosio::detail
@@ -3,11 +3,13 @@
 
 #include <boost/corosio.hpp>
 #include <boost/capy/task.hpp>
-#include <boost/capy/ex/run_async.hpp>
+
+#include "detail/frame_pool.hpp"
 
 #include <atomic>
 #include <exception>
 #include <optional>
+#include <string>
 #include <utility>
 
 namespace corosio = boost::corosio;
@@ -55,14 +57,11 @@ namespace vix::net_corosio
     impl_ = nullptr;
   }
 
-  static capy::task<void>
-  resolve_task(
-      corosio::io_context &ioc,
-      std::string host,
-      std::string service,
-      std::atomic<bool> &done,
-      ResolveResult &out)
+  static capy::task<ResolveResult>
+  resolve_endpoints(corosio::io_context &ioc, std::string host, std::string service)
   {
+    ResolveResult out{};
+
     try
     {
       corosio::resolver r(ioc);
@@ -72,11 +71,9 @@ namespace vix::net_corosio
       if (ec)
       {
         out.error = Error{ErrorCode::resolve_failed};
-        done.store(true, std::memory_order_release);
-        co_return;
+        co_return out;
       }
 
-      out.endpoints.clear();
       out.endpoints.reserve(results.size());
 
       for (auto const &entry : results)
@@ -104,9 +101,22 @@ namespace vix::net_corosio
     }
     catch (...)
     {
+      out.endpoints.clear();
       out.error = Error{ErrorCode::unknown};
     }
 
+    co_return out;
+  }
+
+  static capy::task<void>
+  resolve_task(
+      corosio::io_context &ioc,
+      std::string host,
+      std::string service,
+      std::atomic<bool> &done,
+      ResolveResult &out)
+  {
+    out = co_await resolve_endpoints(ioc, std::move(host), std::move(service));
     done.store(true, std::memory_order_release);
   }
 
@@ -123,7 +133,7 @@ namespace vix::net_corosio
 
     std::atomic<bool> done{false};
 
-    capy::run_async(impl_->ioc->get_executor())(
+    detail::launcher(impl_->ioc->get_executor())(
         resolve_task(*impl_->ioc,
                      std::string(host),
                      std::string(service),
@@ -138,4 +148,12 @@ namespace vix::net_corosio
     return out;
   }
 
+  Task<ResolveResult> Resolver::async_resolve(std::string host, std::string service)
+  {
+    if (!impl_ || !impl_->ioc)
+      co_return ResolveResult{Error{ErrorCode::not_initialized}, {}};
+
+    co_return co_await resolve_endpoints(*impl_->ioc, std::move(host), std::move(service));
+  }
+
 } // namespace vix::net_corosio
@@ -0,0 +1,185 @@
+#include <vix/net_corosio/ring_buffer.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace vix::net_corosio
+{
+  namespace
+  {
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+    /**
+     * @brief Map one memfd twice, back to back. Returns nullptr on failure.
+     *
+     * capacity must be a multiple of the page size.
+     */
+    char *map_mirrored(std::size_t capacity) noexcept
+    {
+      const int fd = ::memfd_create("vix-ring", MFD_CLOEXEC);
+      if (fd < 0)
+        return nullptr;
+
+      char *out = nullptr;
+
+      if (::ftruncate(fd, static_cast<off_t>(capacity)) == 0)
+      {
+        // Reserve both halves first so nothing else lands in between.
+        void *area = ::mmap(nullptr, 2 * capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (area != MAP_FAILED)
+        {
+          auto *base = static_cast<char *>(area);
+
+          const bool ok =
+              ::mmap(base, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+              ::mmap(base + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+
+          if (ok)
+            out = base;
+          else
+            (void)::munmap(area, 2 * capacity);
+        }
+      }
+
+      (void)::close(fd);
+      return out;
+    }
+#endif
+  } // namespace
+
+  RingBuffer::RingBuffer(std::size_t capacity, bool mirror)
+  {
+    capacity = std::max<std::size_t>(capacity, 1);
+
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+    if (mirror)
+    {
+      const long page = ::sysconf(_SC_PAGESIZE);
+      const std::size_t unit = page > 0 ? static_cast<std::size_t>(page) : 4096;
+      const std::size_t rounded = (capacity + unit - 1) / unit * unit;
+
+      if (char *base = map_mirrored(rounded))
+      {
+        base_ = base;
+        capacity_ = rounded;
+        mirrored_ = true;
+        return;
+      }
+    }
+#else
+    (void)mirror;
+#endif
+
+    base_ = new char[capacity];
+    capacity_ = capacity;
+  }
+
+  RingBuffer::RingBuffer(RingBuffer &&other) noexcept
+      : base_(std::exchange(other.base_, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        head_(std::exchange(other.head_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        mirrored_(std::exchange(other.mirrored_, false))
+  {
+  }
+
+  RingBuffer &RingBuffer::operator=(RingBuffer &&other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      base_ = std::exchange(other.base_, nullptr);
+      capacity_ = std::exchange(other.capacity_, 0);
+      head_ = std::exchange(other.head_, 0);
+      size_ = std::exchange(other.size_, 0);
+      mirrored_ = std::exchange(other.mirrored_, false);
+    }
+    return *this;
+  }
+
+  RingBuffer::~RingBuffer()
+  {
+    release();
+  }
+
+  void RingBuffer::release() noexcept
+  {
+    if (!base_)
+      return;
+
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+    if (mirrored_)
+      (void)::munmap(base_, 2 * capacity_);
+    else
+      delete[] base_;
+#else
+    delete[] base_;
+#endif
+
+    base_ = nullptr;
+    capacity_ = 0;
+    head_ = 0;
+    size_ = 0;
+    mirrored_ = false;
+  }
+
+  ConstBuffer RingBuffer::data() const noexcept
+  {
+    return ConstBuffer{base_ + head_, size_};
+  }
+
+  std::string_view RingBuffer::view() const noexcept
+  {
+    return std::string_view(base_ + head_, size_);
+  }
+
+  MutableBuffer RingBuffer::prepare() noexcept
+  {
+    if (mirrored_)
+    {
+      const std::size_t tail = (head_ + size_) % capacity_;
+      return MutableBuffer{base_ + tail, capacity_ - size_};
+    }
+
+    if (head_ != 0)
+    {
+      std::memmove(base_, base_ + head_, size_);
+      head_ = 0;
+    }
+
+    return MutableBuffer{base_ + size_, capacity_ - size_};
+  }
+
+  void RingBuffer::commit(std::size_t n) noexcept
+  {
+    size_ += std::min(n, capacity_ - size_);
+  }
+
+  void RingBuffer::consume(std::size_t n) noexcept
+  {
+    n = std::min(n, size_);
+    size_ -= n;
+
+    // Restart at the front once drained: no compaction needed later.
+    if (size_ == 0)
+      head_ = 0;
+    else if (mirrored_)
+      head_ = (head_ + n) % capacity_;
+    else
+      head_ += n;
+  }
+
+  void RingBuffer::clear() noexcept
+  {
+    head_ = 0;
+    size_ = 0;
+  }
+
+} // namespace vix::net_corosio
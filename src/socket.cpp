@@ -1,18 +1,32 @@
 #include <vix/net_corosio/socket.hpp>
 #include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/timer.hpp>
 
 #include <boost/corosio.hpp>
 #include <boost/capy/buffers.hpp>
-#include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/task.hpp>
-#include <boost/capy/write.hpp>
 
-#include <atomic>
+#include "detail/buffer_seq.hpp"
+#include "detail/composed.hpp"
+#include "detail/context_access.hpp"
+#include "detail/deadline_guard.hpp"
+#include "detail/endpoint.hpp"
+#include "detail/native.hpp"
+#include "detail/readiness.hpp"
+#include "detail/run_blocking.hpp"
+#include "detail/sendfile.hpp"
+#include "detail/socket_options.hpp"
+#include "detail/zerocopy.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <exception>
 #include <string>
 #include <system_error>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace corosio = boost::corosio;
 namespace capy = boost::capy;
@@ -67,12 +81,472 @@ namespace vix::net_corosio
     corosio::io_context *ioc{nullptr};
     corosio::tcp_socket sock;
     SocketState st{SocketState::closed};
+    std::chrono::milliseconds timeout{0};
+
+    SocketOptions opts;
+    bool v6{false}; // address family the socket was opened with
+
+    // zero_copy is the caller's choice and survives a reopen; zc_armed is
+    // SO_ZEROCOPY on the current fd. The counters are MSG_ZEROCOPY sends
+    // issued / released by the kernel on that fd.
+    bool zero_copy{false};
+    bool zc_armed{false};
+    std::uint32_t zc_sent{0};
+    std::uint32_t zc_done{0};
+
+    // Upper bound on waiting for page release when no deadline applies.
+    static constexpr std::chrono::seconds zero_copy_reap_limit{10};
 
     explicit Impl(Context &c)
         : ctx(&c),
           ioc(static_cast<corosio::io_context *>(c.native_handle())),
-          sock(*ioc)
+          sock(*ioc),
+          timeout(c.config().io_timeout),
+          opts(c.config().socket_options)
+    {
+    }
+
+    Error open_family(bool ipv6)
+    {
+      const Error e = detail::open_for(sock, ipv6);
+      if (e)
+        return e;
+
+      st = SocketState::open;
+      v6 = ipv6;
+
+      // Best effort; set_options() on the open socket reports failures.
+      (void)apply_options();
+
+      // A new fd starts without SO_ZEROCOPY; sends fall back to copying
+      // if it cannot be set again.
+      reset_zero_copy();
+      if (zero_copy)
+        zc_armed = !detail::enable_zerocopy(detail::native_fd(sock));
+
+      return Error{ErrorCode::none};
+    }
+
+    void reset_zero_copy() noexcept
+    {
+      zc_armed = false;
+      zc_sent = 0;
+      zc_done = 0;
+    }
+
+    // open() defaults to IPv4: reopen an unconnected socket for the target's family.
+    Error open_for_connect(bool ipv6) noexcept
+    {
+      try
+      {
+        // Keep the current socket if the backend cannot open the other family.
+        if (ipv6 && !detail::has_family_open<corosio::tcp_socket>)
+          return Error{ErrorCode::not_supported};
+
+        if (st == SocketState::open && v6 != ipv6)
+        {
+          sock.close();
+          st = SocketState::closed;
+          reset_zero_copy();
+        }
+
+        if (st == SocketState::closed)
+          return open_family(ipv6);
+
+        return Error{ErrorCode::none};
+      }
+      catch (...)
+      {
+        return Error{ErrorCode::unknown};
+      }
+    }
+
+    Error apply_options() noexcept
+    {
+      if (opts.empty())
+        return Error{ErrorCode::none};
+
+      return detail::apply_options(detail::native_fd(sock), opts);
+    }
+
+    // Linux drops TCP_QUICKACK after the next ACK; keep it in force.
+    void after_read() noexcept
+    {
+      if (opts.quick_ack.value_or(false))
+        (void)detail::set_quick_ack(detail::native_fd(sock), true);
+    }
+
+    // Non-blocking attempt ahead of the reactor; see Config::speculative_io.
+    detail::NativeIo try_read(void *data, std::size_t size) noexcept
+    {
+      if (!speculative())
+        return detail::NativeIo{};
+
+      const auto r = detail::try_recv(detail::native_fd(sock), data, size);
+      if (r.progressed())
+        after_read();
+      return r;
+    }
+
+    detail::NativeIo try_write(const void *data, std::size_t size) noexcept
+    {
+      if (!speculative())
+        return detail::NativeIo{};
+
+      return detail::try_send(detail::native_fd(sock), data, size);
+    }
+
+    detail::NativeIo try_readv(std::span<const MutableBuffer> buffers) noexcept
+    {
+      if (!speculative())
+        return detail::NativeIo{};
+
+      const auto r = detail::try_readv(detail::native_fd(sock), buffers);
+      if (r.progressed())
+        after_read();
+      return r;
+    }
+
+    detail::NativeIo try_writev(std::span<const ConstBuffer> buffers) noexcept
+    {
+      if (!speculative())
+        return detail::NativeIo{};
+
+      return detail::try_writev(detail::native_fd(sock), buffers);
+    }
+
+    bool speculative() const noexcept
+    {
+      return ctx && ctx->config().speculative_io && st == SocketState::connected;
+    }
+
+    bool use_zero_copy(std::size_t size) const noexcept
+    {
+      return zero_copy && zc_armed && ctx && st == SocketState::connected &&
+             size >= ctx->config().zero_copy_min_bytes;
+    }
+
+    void reap_zero_copy() noexcept
+    {
+      zc_done += detail::reap_zerocopy(detail::native_fd(sock)).completed;
+    }
+
+    /**
+     * @brief write_all() with MSG_ZEROCOPY; returns once the kernel released
+     * every page, so the caller owns the buffer again.
+     *
+     * Sends the kernel cannot take right away go through the reactor as
+     * ordinary (copying) writes. The reactor does not expose error-queue
+     * readiness, so outstanding completions are polled on the timer wheel
+     * with backoff; without a deadline, for at most the socket timeout or
+     * zero_copy_reap_limit.
+     */
+    Task<IoResult> write_all_zero_copy(const char *data, std::size_t size, Deadline deadline)
+    {
+      const int fd = detail::native_fd(sock);
+      const auto until = detail::effective_deadline(deadline, std::chrono::milliseconds{0});
+
+      IoResult out{Error{ErrorCode::none}, 0};
+
+      while (out.bytes < size)
+      {
+        reap_zero_copy();
+
+        const auto zc = detail::try_send_zerocopy(fd, data + out.bytes, size - out.bytes);
+        if (zc.progressed())
+        {
+          ++zc_sent;
+          out.bytes += zc.bytes;
+          continue;
+        }
+
+        if (!zc.would_block)
+        {
+          out.error = Error{ErrorCode::write_failed};
+          break;
+        }
+
+        detail::DeadlineGuard guard;
+        if (!arm(deadline, guard))
+        {
+          out.error = Error{ErrorCode::timeout};
+          break;
+        }
+
+        try
+        {
+          auto r = co_await sock.write_some(capy::const_buffer(data + out.bytes, size - out.bytes));
+          guard.disarm();
+          const auto ec = detail::io_error(r);
+
+          if (ec)
+          {
+            out.error = Error{guard.expired() ? ErrorCode::timeout : ErrorCode::write_failed};
+            break;
+          }
+
+          out.bytes += detail::io_bytes(r);
+        }
+        catch (...)
+        {
+          out.error = Error{ErrorCode::unknown};
+          break;
+        }
+      }
+
+      // Pinned pages stay in use until the peer acknowledged them. This wait
+      // happens even after an error: the caller may reuse the buffer next.
+      const auto reap_until = until ? *until
+                                    : Deadline::clock::now() + (timeout.count() > 0 ? timeout : zero_copy_reap_limit);
+
+      Timer backoff(*ctx);
+      std::chrono::milliseconds step{1};
+
+      for (;;)
+      {
+        reap_zero_copy();
+        if (zc_done == zc_sent)
+          break;
+
+        if (reap_until <= Deadline::clock::now())
+        {
+          if (out.error.ok())
+            out.error = Error{ErrorCode::timeout};
+          break;
+        }
+
+        backoff.expires_after(step);
+        (void)co_await backoff.async_wait();
+        step = std::min(step * 2, std::chrono::milliseconds(16));
+      }
+
+      co_return out;
+    }
+
+    // Reactor write of a whole chunk, one guarded write_some() per step.
+    Task<IoResult> write_chunk(const char *data, std::size_t size, Deadline deadline)
     {
+      IoResult out{Error{ErrorCode::none}, 0};
+
+      while (out.bytes < size)
+      {
+        detail::DeadlineGuard guard;
+        if (!arm(deadline, guard))
+        {
+          out.error = Error{ErrorCode::timeout};
+          break;
+        }
+
+        try
+        {
+          auto r = co_await sock.write_some(capy::const_buffer(data + out.bytes, size - out.bytes));
+          guard.disarm();
+          const auto ec = detail::io_error(r);
+
+          if (ec)
+          {
+            out.error = Error{guard.expired() ? ErrorCode::timeout : ErrorCode::write_failed};
+            break;
+          }
+
+          out.bytes += detail::io_bytes(r);
+        }
+        catch (...)
+        {
+          out.error = Error{ErrorCode::unknown};
+          break;
+        }
+      }
+
+      co_return out;
+    }
+
+    /**
+     * @brief File-to-socket transfer without a user-space copy.
+     *
+     * sendfile() for regular files, splice() for pipes. When the socket
+     * buffer is full (or the pipe empty) the transfer parks on readiness
+     * and retries the same syscall, so every byte stays zero-copy. Only
+     * platforms without those syscalls or readiness waits copy through a
+     * bounce buffer written by the reactor.
+     */
+    Task<IoResult> send_file(detail::FileSource src, std::uint64_t offset, std::size_t length,
+                             bool to_eof, Deadline deadline)
+    {
+      constexpr std::size_t bounce_size = 64 * 1024;
+
+      const int fd = detail::native_fd(sock);
+      detail::ensure_nonblocking(fd);
+
+      const auto until = detail::effective_deadline(deadline, std::chrono::milliseconds{0});
+
+      std::vector<char> bounce;
+      IoResult out{Error{ErrorCode::none}, 0};
+
+      while (to_eof || out.bytes < length)
+      {
+        const std::size_t want = to_eof ? bounce_size * 16 : length - out.bytes;
+
+        const auto step = detail::try_send_file(fd, src, offset + out.bytes, want);
+        if (step.progressed())
+        {
+          out.bytes += step.bytes;
+          continue;
+        }
+
+        if (step.closed)
+        {
+          if (!to_eof)
+            out.error = Error{ErrorCode::read_failed}; // source shorter than length
+          break;
+        }
+
+        if (!step.would_block)
+        {
+          out.error = Error{ErrorCode::write_failed};
+          break;
+        }
+
+        if (until && *until <= Deadline::clock::now())
+        {
+          out.error = Error{ErrorCode::timeout};
+          break;
+        }
+
+        if constexpr (detail::has_send_file && detail::has_readiness_wait)
+        {
+          // An empty pipe, not a full socket: wait for the producer.
+          const bool pipe_empty = src.pipe && !detail::poll_ready(src.fd, false);
+
+          const Error e = co_await wait_fd(pipe_empty ? src.fd : fd, !pipe_empty, deadline);
+          if (e)
+          {
+            out.error = e;
+            break;
+          }
+
+          continue;
+        }
+
+        // Copying fallback from here on.
+        if (src.pipe && !detail::poll_ready(src.fd, false))
+        {
+          Timer backoff(*ctx);
+          backoff.expires_after(std::chrono::milliseconds(1));
+          (void)co_await backoff.async_wait();
+          continue;
+        }
+
+        if (bounce.empty())
+          bounce.resize(bounce_size);
+
+        const std::size_t chunk = to_eof ? bounce_size : std::min(bounce_size, length - out.bytes);
+        const auto got = detail::read_source(src, offset + out.bytes, bounce.data(), chunk);
+
+        if (got.closed)
+        {
+          if (!to_eof)
+            out.error = Error{ErrorCode::read_failed};
+          break;
+        }
+
+        if (!got.progressed())
+        {
+          out.error = Error{ErrorCode::read_failed};
+          break;
+        }
+
+        const auto w = co_await write_chunk(bounce.data(), got.bytes, deadline);
+        out.bytes += w.bytes;
+
+        if (!w.ok())
+        {
+          out.error = w.error;
+          break;
+        }
+      }
+
+      co_return out;
+    }
+
+    // Arm guard for one operation. Returns false if the deadline already passed.
+    bool arm(const Deadline &d, detail::DeadlineGuard &guard)
+    {
+      return arm(d, guard, &detail::cancel_io<corosio::tcp_socket>, &sock);
+    }
+
+    bool arm(const Deadline &d, detail::DeadlineGuard &guard,
+             detail::DeadlineGuard::cancel_fn fn, void *target)
+    {
+      const auto when = detail::effective_deadline(d, timeout);
+      if (!when || !ctx)
+        return true;
+
+      if (*when <= Deadline::clock::now())
+        return false;
+
+      guard.arm(detail::ContextAccess::timers(*ctx), *when, fn, target);
+      return true;
+    }
+
+    /**
+     * @brief Park until the fd is readable or writable, moving no data.
+     *
+     * Readable includes EOF and pending errors. Already-ready sockets
+     * complete without registering anything.
+     */
+    Task<Error> wait_ready(bool for_write, Deadline deadline)
+    {
+      if (st != SocketState::connected)
+        co_return Error{ErrorCode::invalid_state};
+
+      co_return co_await wait_fd(detail::native_fd(sock), for_write, deadline);
+    }
+
+    // wait_ready() on any descriptor, e.g. the pipe feeding send_file().
+    Task<Error> wait_fd(int fd, bool for_write, Deadline deadline)
+    {
+      if (fd < 0 || !detail::has_readiness_wait)
+        co_return Error{ErrorCode::not_supported};
+
+      if (detail::poll_ready(fd, for_write))
+        co_return Error{ErrorCode::none};
+
+      auto &svc = detail::ContextAccess::readiness(*ctx);
+
+      detail::ReadyWait w{};
+      w.fd = fd;
+      w.write = for_write;
+      w.ex = ctx->get_executor();
+      w.svc = &svc;
+
+      detail::DeadlineGuard guard;
+      if (!arm(deadline, guard, &detail::ReadinessService::cancel_wait, &w))
+        co_return Error{ErrorCode::timeout};
+
+      Error e{ErrorCode::unknown};
+
+      try
+      {
+        e = co_await svc.wait(w);
+      }
+      catch (...)
+      {
+        e = Error{ErrorCode::unknown};
+      }
+
+      guard.disarm();
+
+      if (e.code == ErrorCode::canceled)
+      {
+        if (guard.expired())
+          co_return Error{ErrorCode::timeout};
+
+        if (st != SocketState::connected)
+          co_return Error{ErrorCode::connection_closed};
+      }
+
+      co_return e;
     }
   };
 
@@ -82,145 +556,526 @@ namespace vix::net_corosio
     return fallback;
   }
 
-  static bool parse_endpoint(const TcpEndpoint &ep, corosio::endpoint &out)
+  Socket::Socket(Context &ctx)
+      : impl_(new Impl(ctx))
   {
-    if (ep.port == 0)
-      return false;
+  }
 
-    if (ep.address == "localhost" || ep.address == "127.0.0.1")
+  Socket::Socket(Socket &&other) noexcept
+      : impl_(other.impl_)
+  {
+    other.impl_ = nullptr;
+  }
+
+  Socket &Socket::operator=(Socket &&other) noexcept
+  {
+    if (this != &other)
     {
-      out = corosio::endpoint(corosio::ipv4_address::loopback(), ep.port);
-      return true;
+      delete impl_;
+      impl_ = other.impl_;
+      other.impl_ = nullptr;
     }
+    return *this;
+  }
 
-    corosio::ipv4_address addr4;
-    if (!corosio::parse_ipv4_address(ep.address.c_str(), addr4))
+  Socket::~Socket()
+  {
+    if (impl_)
     {
-      out = corosio::endpoint(addr4, ep.port);
-      return true;
+      close();
+      delete impl_;
+      impl_ = nullptr;
+    }
+  }
+
+  SocketState Socket::state() const noexcept
+  {
+    return impl_ ? impl_->st : SocketState::closed;
+  }
+
+  Error Socket::open()
+  {
+    if (!impl_ || !impl_->ioc)
+      return Error{ErrorCode::not_initialized};
+
+    if (impl_->st != SocketState::closed)
+      return Error{ErrorCode::none};
+
+    try
+    {
+      return impl_->open_family(false);
+    }
+    catch (...)
+    {
+      return Error{ErrorCode::unknown};
     }
+  }
+
+  Error Socket::connect(const TcpEndpoint &ep, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return Error{ErrorCode::not_initialized};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_connect(ep, deadline); });
+  }
+
+  IoResult Socket::connect_with_data(const TcpEndpoint &ep, const void *data, std::size_t size,
+                                     Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_connect_with_data(ep, data, size, deadline); });
+  }
+
+  IoResult Socket::read_some(void *data, std::size_t size, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    // Data already queued in the kernel: no frame, no loop iteration.
+    if (data && size != 0)
+    {
+      const auto fast = impl_->try_read(data, size);
+      if (fast.progressed())
+        return IoResult{Error{ErrorCode::none}, fast.bytes};
+    }
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_read_some(data, size, deadline); });
+  }
+
+  IoResult Socket::write_some(const void *data, std::size_t size, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (data && size != 0)
+    {
+      const auto fast = impl_->try_write(data, size);
+      if (fast.progressed())
+        return IoResult{Error{ErrorCode::none}, fast.bytes};
+    }
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_write_some(data, size, deadline); });
+  }
+
+  IoResult Socket::read_some(std::span<const MutableBuffer> buffers, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (buffer_size(buffers) != 0)
+    {
+      const auto fast = impl_->try_readv(buffers);
+      if (fast.progressed())
+        return IoResult{Error{ErrorCode::none}, fast.bytes};
+    }
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_read_some(buffers, deadline); });
+  }
+
+  IoResult Socket::write_some(std::span<const ConstBuffer> buffers, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (buffer_size(buffers) != 0)
+    {
+      const auto fast = impl_->try_writev(buffers);
+      if (fast.progressed())
+        return IoResult{Error{ErrorCode::none}, fast.bytes};
+    }
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_write_some(buffers, deadline); });
+  }
+
+  IoResult Socket::write_all(const void *data, std::size_t size, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_write_all(data, size, deadline); });
+  }
+
+  IoResult Socket::write_all(std::span<const ConstBuffer> buffers, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_write_all(buffers, deadline); });
+  }
+
+  IoResult Socket::read_exact(void *data, std::size_t size, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_read_exact(data, size, deadline); });
+  }
+
+  namespace
+  {
+    IoResult to_try_result(const detail::NativeIo &r, ErrorCode failure) noexcept
+    {
+      if (r.progressed())
+        return IoResult{Error{ErrorCode::none}, r.bytes};
+
+      if (r.would_block)
+        return IoResult{Error{ErrorCode::would_block}, 0};
+
+      if (r.closed)
+        return IoResult{Error{ErrorCode::connection_closed}, 0};
+
+      return IoResult{Error{failure}, 0};
+    }
+  } // namespace
+
+  IoResult Socket::try_read_some(void *data, std::size_t size)
+  {
+    if (!impl_ || !impl_->ioc)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (!data || size == 0)
+      return IoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    if (impl_->st != SocketState::connected)
+      return IoResult{Error{ErrorCode::invalid_state}, 0};
+
+    const int fd = detail::native_fd(impl_->sock);
+    if (fd < 0)
+      return IoResult{Error{ErrorCode::not_supported}, 0};
+
+    const auto r = detail::try_recv(fd, data, size);
+    if (r.progressed())
+      impl_->after_read();
+
+    return to_try_result(r, ErrorCode::read_failed);
+  }
+
+  IoResult Socket::try_write_some(const void *data, std::size_t size)
+  {
+    if (!impl_ || !impl_->ioc)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (!data || size == 0)
+      return IoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    if (impl_->st != SocketState::connected)
+      return IoResult{Error{ErrorCode::invalid_state}, 0};
+
+    const int fd = detail::native_fd(impl_->sock);
+    if (fd < 0)
+      return IoResult{Error{ErrorCode::not_supported}, 0};
+
+    return to_try_result(detail::try_send(fd, data, size), ErrorCode::write_failed);
+  }
+
+  IoResult Socket::try_read_some(std::span<const MutableBuffer> buffers)
+  {
+    if (!impl_ || !impl_->ioc)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (buffer_size(buffers) == 0)
+      return IoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    if (impl_->st != SocketState::connected)
+      return IoResult{Error{ErrorCode::invalid_state}, 0};
+
+    const int fd = detail::native_fd(impl_->sock);
+    if (fd < 0)
+      return IoResult{Error{ErrorCode::not_supported}, 0};
+
+    const auto r = detail::try_readv(fd, buffers);
+    if (r.progressed())
+      impl_->after_read();
+
+    return to_try_result(r, ErrorCode::read_failed);
+  }
+
+  IoResult Socket::try_write_some(std::span<const ConstBuffer> buffers)
+  {
+    if (!impl_ || !impl_->ioc)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (buffer_size(buffers) == 0)
+      return IoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    if (impl_->st != SocketState::connected)
+      return IoResult{Error{ErrorCode::invalid_state}, 0};
+
+    const int fd = detail::native_fd(impl_->sock);
+    if (fd < 0)
+      return IoResult{Error{ErrorCode::not_supported}, 0};
+
+    return to_try_result(detail::try_writev(fd, buffers), ErrorCode::write_failed);
+  }
+
+  Error Socket::wait_readable(Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return Error{ErrorCode::not_initialized};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_wait_readable(deadline); });
+  }
+
+  Error Socket::wait_writable(Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return Error{ErrorCode::not_initialized};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_wait_writable(deadline); });
+  }
+
+  Task<Error> Socket::async_wait_readable(Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      co_return Error{ErrorCode::not_initialized};
+
+    co_return co_await impl_->wait_ready(false, deadline);
+  }
+
+  Task<Error> Socket::async_wait_writable(Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      co_return Error{ErrorCode::not_initialized};
+
+    co_return co_await impl_->wait_ready(true, deadline);
+  }
+
+  Task<Error> Socket::async_connect(TcpEndpoint ep, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc)
+      co_return Error{ErrorCode::not_initialized};
+
+    corosio::endpoint target{};
+    if (ep.port == 0 || !detail::parse_address(ep.address, ep.port, false, target))
+      co_return Error{ErrorCode::invalid_argument};
+
+    const bool v6 = !target.is_v4();
+    const bool strict = impl_->ctx ? impl_->ctx->config().strict_checks : true;
+
+    const Error e = impl_->open_for_connect(v6);
+    if (strict && e)
+      co_return e;
+
+    detail::DeadlineGuard guard;
+    if (!impl_->arm(deadline, guard))
+      co_return Error{ErrorCode::timeout};
+
+    Error out{ErrorCode::unknown};
+
+    try
+    {
+      auto r = co_await impl_->sock.connect(target);
+      guard.disarm();
+      const auto ec = detail::io_error(r);
+
+      if (ec && guard.expired())
+        co_return Error{ErrorCode::timeout};
+
+      if (ec)
+        co_return Error{map_io_error_to_code(ec, ErrorCode::connect_failed)};
+
+      impl_->st = SocketState::connected;
+      out = Error{ErrorCode::none};
+    }
+    catch (...)
+    {
+      out = Error{ErrorCode::unknown};
+    }
+
+    co_return out;
+  }
+
+  Task<IoResult> Socket::async_connect_with_data(TcpEndpoint ep, const void *data, std::size_t size,
+                                                 Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc)
+      co_return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (!data || size == 0)
+      co_return IoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    corosio::endpoint target{};
+    if (ep.port == 0 || !detail::parse_address(ep.address, ep.port, false, target))
+      co_return IoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    if (impl_->st == SocketState::connected)
+      co_return IoResult{Error{ErrorCode::invalid_state}, 0};
+
+    const Error opened = impl_->open_for_connect(!target.is_v4());
+    if (opened)
+      co_return IoResult{opened, 0};
+
+    // Unsupported platforms just take the regular handshake.
+    (void)detail::set_fast_open_connect(detail::native_fd(impl_->sock));
+
+    const auto d = detail::composed_deadline(deadline, impl_->timeout);
 
-    return false;
-  }
+    const Error e = co_await async_connect(std::move(ep), d);
+    if (e)
+      co_return IoResult{e, 0};
 
-  Socket::Socket(Context &ctx)
-      : impl_(new Impl(ctx))
-  {
+    co_return co_await async_write_some(data, size, d);
   }
 
-  Socket::Socket(Socket &&other) noexcept
-      : impl_(other.impl_)
+  Task<IoResult> Socket::async_read_some(void *data, std::size_t size, Deadline deadline)
   {
-    other.impl_ = nullptr;
-  }
+    IoResult out{};
+    out.error = Error{ErrorCode::unknown};
+    out.bytes = 0;
 
-  Socket &Socket::operator=(Socket &&other) noexcept
-  {
-    if (this != &other)
+    if (!impl_ || !impl_->ioc)
     {
-      delete impl_;
-      impl_ = other.impl_;
-      other.impl_ = nullptr;
+      out.error = Error{ErrorCode::not_initialized};
+      co_return out;
     }
-    return *this;
-  }
 
-  Socket::~Socket()
-  {
-    if (impl_)
+    if (!data || size == 0)
     {
-      close();
-      delete impl_;
-      impl_ = nullptr;
+      out.error = Error{ErrorCode::invalid_argument};
+      co_return out;
     }
-  }
 
-  SocketState Socket::state() const noexcept
-  {
-    return impl_ ? impl_->st : SocketState::closed;
-  }
+    const bool strict = impl_->ctx ? impl_->ctx->config().strict_checks : true;
+    if (strict && impl_->st != SocketState::connected)
+    {
+      out.error = Error{ErrorCode::invalid_state};
+      co_return out;
+    }
 
-  Error Socket::open()
-  {
-    if (!impl_ || !impl_->ioc)
-      return Error{ErrorCode::not_initialized};
+    const auto fast = impl_->try_read(data, size);
+    if (fast.progressed())
+    {
+      out.error = Error{ErrorCode::none};
+      out.bytes = fast.bytes;
+      co_return out;
+    }
 
-    if (impl_->st != SocketState::closed)
-      return Error{ErrorCode::none};
+    detail::DeadlineGuard guard;
+    if (!impl_->arm(deadline, guard))
+    {
+      out.error = Error{ErrorCode::timeout};
+      co_return out;
+    }
 
     try
     {
-      impl_->sock.open();
-      impl_->st = SocketState::open;
-      return Error{ErrorCode::none};
+      auto r = co_await impl_->sock.read_some(capy::mutable_buffer(data, size));
+      guard.disarm();
+      const auto ec = detail::io_error(r);
+
+      if (ec && guard.expired())
+      {
+        out.error = Error{ErrorCode::timeout};
+        out.bytes = 0;
+        co_return out;
+      }
+
+      if (ec)
+      {
+        out.error = Error{map_io_error_to_code(ec, ErrorCode::read_failed)};
+        out.bytes = 0;
+        co_return out;
+      }
+
+      out.error = Error{ErrorCode::none};
+      out.bytes = detail::io_bytes(r);
+      impl_->after_read();
     }
     catch (...)
     {
-      return Error{ErrorCode::unknown};
+      out.error = Error{ErrorCode::unknown};
+      out.bytes = 0;
     }
+
+    co_return out;
   }
 
-  Error Socket::connect(const TcpEndpoint &ep)
+  Task<IoResult> Socket::async_write_some(const void *data, std::size_t size, Deadline deadline)
   {
-    if (!impl_ || !impl_->ioc)
-      return Error{ErrorCode::not_initialized};
-
-    const bool strict = impl_->ctx ? impl_->ctx->config().strict_checks : true;
+    IoResult out{};
+    out.error = Error{ErrorCode::unknown};
+    out.bytes = 0;
 
-    if (strict && impl_->st == SocketState::closed)
+    if (!impl_ || !impl_->ioc)
     {
-      auto e = open();
-      if (e)
-        return e;
+      out.error = Error{ErrorCode::not_initialized};
+      co_return out;
     }
-    else if (!strict && impl_->st == SocketState::closed)
+
+    if (!data || size == 0)
     {
-      (void)open();
+      out.error = Error{ErrorCode::invalid_argument};
+      co_return out;
     }
 
-    corosio::endpoint target{};
-    if (!parse_endpoint(ep, target))
-      return Error{ErrorCode::invalid_argument};
+    const bool strict = impl_->ctx ? impl_->ctx->config().strict_checks : true;
+    if (strict && impl_->st != SocketState::connected)
+    {
+      out.error = Error{ErrorCode::invalid_state};
+      co_return out;
+    }
 
-    std::atomic<bool> done{false};
-    Error out{ErrorCode::unknown};
+    const auto fast = impl_->try_write(data, size);
+    if (fast.progressed())
+    {
+      out.error = Error{ErrorCode::none};
+      out.bytes = fast.bytes;
+      co_return out;
+    }
 
-    auto task = [&]() -> capy::task<void>
+    detail::DeadlineGuard guard;
+    if (!impl_->arm(deadline, guard))
     {
-      try
-      {
-        auto r = co_await impl_->sock.connect(target);
-        const auto ec = detail::io_error(r);
+      out.error = Error{ErrorCode::timeout};
+      co_return out;
+    }
 
-        if (ec)
-        {
-          out = Error{map_io_error_to_code(ec, ErrorCode::connect_failed)};
-          done.store(true, std::memory_order_release);
-          co_return;
-        }
+    try
+    {
+      auto r = co_await impl_->sock.write_some(capy::const_buffer(data, size));
+      guard.disarm();
+      const auto ec = detail::io_error(r);
 
-        impl_->st = SocketState::connected;
-        out = Error{ErrorCode::none};
-      }
-      catch (...)
+      if (ec && guard.expired())
       {
-        out = Error{ErrorCode::unknown};
+        out.error = Error{ErrorCode::timeout};
+        out.bytes = 0;
+        co_return out;
       }
 
-      done.store(true, std::memory_order_release);
-    };
-
-    capy::run_async(impl_->ioc->get_executor())(task());
+      if (ec)
+      {
+        out.error = Error{map_io_error_to_code(ec, ErrorCode::write_failed)};
+        out.bytes = 0;
+        co_return out;
+      }
 
-    while (!done.load(std::memory_order_acquire))
+      out.error = Error{ErrorCode::none};
+      out.bytes = detail::io_bytes(r);
+    }
+    catch (...)
     {
-      impl_->ioc->run_one();
+      out.error = Error{ErrorCode::unknown};
+      out.bytes = 0;
     }
 
-    return out;
+    co_return out;
   }
 
-  IoResult Socket::read_some(void *data, std::size_t size)
+  Task<IoResult> Socket::async_read_some(std::span<const MutableBuffer> buffers, Deadline deadline)
   {
     IoResult out{};
     out.error = Error{ErrorCode::unknown};
@@ -229,62 +1084,74 @@ namespace vix::net_corosio
     if (!impl_ || !impl_->ioc)
     {
       out.error = Error{ErrorCode::not_initialized};
-      return out;
+      co_return out;
     }
 
-    if (!data || size == 0)
+    if (buffer_size(buffers) == 0)
     {
       out.error = Error{ErrorCode::invalid_argument};
-      return out;
+      co_return out;
     }
 
     const bool strict = impl_->ctx ? impl_->ctx->config().strict_checks : true;
     if (strict && impl_->st != SocketState::connected)
     {
       out.error = Error{ErrorCode::invalid_state};
-      return out;
+      co_return out;
     }
 
-    std::atomic<bool> done{false};
+    const auto fast = impl_->try_readv(buffers);
+    if (fast.progressed())
+    {
+      out.error = Error{ErrorCode::none};
+      out.bytes = fast.bytes;
+      co_return out;
+    }
 
-    auto task = [&]() -> capy::task<void>
+    detail::DeadlineGuard guard;
+    if (!impl_->arm(deadline, guard))
     {
-      try
-      {
-        auto r = co_await impl_->sock.read_some(capy::mutable_buffer(data, size));
-        const auto ec = detail::io_error(r);
+      out.error = Error{ErrorCode::timeout};
+      co_return out;
+    }
 
-        if (ec)
-        {
-          out.error = Error{map_io_error_to_code(ec, ErrorCode::read_failed)};
-          out.bytes = 0;
-          done.store(true, std::memory_order_release);
-          co_return;
-        }
+    try
+    {
+      detail::SmallArray<capy::mutable_buffer> seq(buffers.size());
+      detail::to_backend(buffers, 0, seq);
 
-        out.error = Error{ErrorCode::none};
-        out.bytes = detail::io_bytes(r);
-      }
-      catch (...)
+      auto r = co_await impl_->sock.read_some(seq.span());
+      guard.disarm();
+      const auto ec = detail::io_error(r);
+
+      if (ec && guard.expired())
       {
-        out.error = Error{ErrorCode::unknown};
+        out.error = Error{ErrorCode::timeout};
         out.bytes = 0;
+        co_return out;
       }
 
-      done.store(true, std::memory_order_release);
-    };
-
-    capy::run_async(impl_->ioc->get_executor())(task());
+      if (ec)
+      {
+        out.error = Error{map_io_error_to_code(ec, ErrorCode::read_failed)};
+        out.bytes = 0;
+        co_return out;
+      }
 
-    while (!done.load(std::memory_order_acquire))
+      out.error = Error{ErrorCode::none};
+      out.bytes = detail::io_bytes(r);
+      impl_->after_read();
+    }
+    catch (...)
     {
-      impl_->ioc->run_one();
+      out.error = Error{ErrorCode::unknown};
+      out.bytes = 0;
     }
 
-    return out;
+    co_return out;
   }
 
-  IoResult Socket::write_some(const void *data, std::size_t size)
+  Task<IoResult> Socket::async_write_some(std::span<const ConstBuffer> buffers, Deadline deadline)
   {
     IoResult out{};
     out.error = Error{ErrorCode::unknown};
@@ -293,59 +1160,275 @@ namespace vix::net_corosio
     if (!impl_ || !impl_->ioc)
     {
       out.error = Error{ErrorCode::not_initialized};
-      return out;
+      co_return out;
     }
 
-    if (!data || size == 0)
+    if (buffer_size(buffers) == 0)
     {
       out.error = Error{ErrorCode::invalid_argument};
-      return out;
+      co_return out;
     }
 
     const bool strict = impl_->ctx ? impl_->ctx->config().strict_checks : true;
     if (strict && impl_->st != SocketState::connected)
     {
       out.error = Error{ErrorCode::invalid_state};
-      return out;
+      co_return out;
     }
 
-    std::atomic<bool> done{false};
+    const auto fast = impl_->try_writev(buffers);
+    if (fast.progressed())
+    {
+      out.error = Error{ErrorCode::none};
+      out.bytes = fast.bytes;
+      co_return out;
+    }
 
-    auto task = [&]() -> capy::task<void>
+    detail::DeadlineGuard guard;
+    if (!impl_->arm(deadline, guard))
     {
-      try
-      {
-        auto r = co_await capy::write(impl_->sock, capy::const_buffer(data, size));
-        const auto ec = detail::io_error(r);
+      out.error = Error{ErrorCode::timeout};
+      co_return out;
+    }
 
-        if (ec)
-        {
-          out.error = Error{map_io_error_to_code(ec, ErrorCode::write_failed)};
-          out.bytes = 0;
-          done.store(true, std::memory_order_release);
-          co_return;
-        }
+    try
+    {
+      detail::SmallArray<capy::const_buffer> seq(buffers.size());
+      detail::to_backend(buffers, 0, seq);
+
+      auto r = co_await impl_->sock.write_some(seq.span());
+      guard.disarm();
+      const auto ec = detail::io_error(r);
 
-        out.error = Error{ErrorCode::none};
-        out.bytes = detail::io_bytes(r);
+      if (ec && guard.expired())
+      {
+        out.error = Error{ErrorCode::timeout};
+        out.bytes = 0;
+        co_return out;
       }
-      catch (...)
+
+      if (ec)
       {
-        out.error = Error{ErrorCode::unknown};
+        out.error = Error{map_io_error_to_code(ec, ErrorCode::write_failed)};
         out.bytes = 0;
+        co_return out;
       }
 
-      done.store(true, std::memory_order_release);
-    };
+      out.error = Error{ErrorCode::none};
+      out.bytes = detail::io_bytes(r);
+    }
+    catch (...)
+    {
+      out.error = Error{ErrorCode::unknown};
+      out.bytes = 0;
+    }
+
+    co_return out;
+  }
+
+  Task<IoResult> Socket::async_write_all(const void *data, std::size_t size, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc)
+      co_return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (!data || size == 0)
+      co_return IoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    const auto d = detail::composed_deadline(deadline, impl_->timeout);
+
+    if (impl_->use_zero_copy(size))
+      co_return co_await impl_->write_all_zero_copy(static_cast<const char *>(data), size, d);
+
+    co_return co_await detail::write_all<IoResult>(*this, data, size, d);
+  }
+
+  Task<IoResult> Socket::async_write_all(std::span<const ConstBuffer> buffers, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc)
+      co_return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (buffer_size(buffers) == 0)
+      co_return IoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    const auto d = detail::composed_deadline(deadline, impl_->timeout);
+    co_return co_await detail::write_all<IoResult>(*this, buffers, d);
+  }
+
+  Task<IoResult> Socket::async_read_exact(void *data, std::size_t size, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc)
+      co_return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (!data || size == 0)
+      co_return IoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    const auto d = detail::composed_deadline(deadline, impl_->timeout);
+    co_return co_await detail::read_exact<IoResult>(*this, data, size, d);
+  }
+
+  IoResult Socket::send_file(int file_fd, std::uint64_t offset, std::size_t length, Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_send_file(file_fd, offset, length, deadline); });
+  }
+
+  IoResult Socket::send_file(const std::string &path, std::uint64_t offset, std::size_t length,
+                             Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc || !impl_->ctx)
+      return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_send_file(path, offset, length, deadline); });
+  }
+
+  Task<IoResult> Socket::async_send_file(int file_fd, std::uint64_t offset, std::size_t length,
+                                         Deadline deadline)
+  {
+    if (!impl_ || !impl_->ioc)
+      co_return IoResult{Error{ErrorCode::not_initialized}, 0};
+
+    const bool strict = impl_->ctx ? impl_->ctx->config().strict_checks : true;
+    if (strict && impl_->st != SocketState::connected)
+      co_return IoResult{Error{ErrorCode::invalid_state}, 0};
+
+    if (detail::native_fd(impl_->sock) < 0)
+      co_return IoResult{Error{ErrorCode::not_supported}, 0};
+
+    detail::FileSource src{};
+    const Error e = detail::inspect_source(file_fd, src);
+    if (e)
+      co_return IoResult{e, 0};
+
+    bool to_eof = false;
+
+    if (src.pipe)
+    {
+      // Pipes have no position; offset must be 0.
+      if (offset != 0)
+        co_return IoResult{Error{ErrorCode::invalid_argument}, 0};
+
+      to_eof = length == 0;
+    }
+    else
+    {
+      if (offset > src.size)
+        co_return IoResult{Error{ErrorCode::invalid_argument}, 0};
+
+      if (length == 0)
+        length = static_cast<std::size_t>(src.size - offset);
+
+      if (length == 0)
+        co_return IoResult{Error{ErrorCode::none}, 0};
+    }
+
+    const auto d = detail::composed_deadline(deadline, impl_->timeout);
+    co_return co_await impl_->send_file(src, offset, length, to_eof, d);
+  }
+
+  Task<IoResult> Socket::async_send_file(std::string path, std::uint64_t offset, std::size_t length,
+                                         Deadline deadline)
+  {
+    const int fd = detail::open_for_send(path.c_str());
+    if (fd < 0)
+      co_return IoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    IoResult out{Error{ErrorCode::unknown}, 0};
 
-    capy::run_async(impl_->ioc->get_executor())(task());
+    try
+    {
+      out = co_await async_send_file(fd, offset, length, deadline);
+    }
+    catch (...)
+    {
+      out = IoResult{Error{ErrorCode::unknown}, 0};
+    }
+
+    detail::close_file(fd);
+    co_return out;
+  }
+
+  TcpEndpoint Socket::local_endpoint() const
+  {
+    if (!impl_ || impl_->st == SocketState::closed)
+      return TcpEndpoint{};
+
+    return detail::endpoint_of(detail::native_fd(impl_->sock), true);
+  }
+
+  TcpEndpoint Socket::remote_endpoint() const
+  {
+    if (!impl_ || impl_->st != SocketState::connected)
+      return TcpEndpoint{};
+
+    return detail::endpoint_of(detail::native_fd(impl_->sock), false);
+  }
+
+  Error Socket::set_options(const SocketOptions &opts)
+  {
+    if (!impl_ || !impl_->ioc)
+      return Error{ErrorCode::not_initialized};
+
+    try
+    {
+      impl_->opts.merge(opts);
+    }
+    catch (...)
+    {
+      return Error{ErrorCode::unknown};
+    }
+
+    if (impl_->st == SocketState::closed)
+      return Error{ErrorCode::none};
+
+    return detail::apply_options(detail::native_fd(impl_->sock), opts);
+  }
 
-    while (!done.load(std::memory_order_acquire))
+  SocketOptions Socket::options() const
+  {
+    return impl_ ? impl_->opts : SocketOptions{};
+  }
+
+  Error Socket::set_zero_copy(bool enable)
+  {
+    if (!impl_ || !impl_->ioc)
+      return Error{ErrorCode::not_initialized};
+
+    if (!enable)
     {
-      impl_->ioc->run_one();
+      impl_->zero_copy = false;
+      return Error{ErrorCode::none};
     }
 
-    return out;
+    if (impl_->st == SocketState::closed)
+      return Error{ErrorCode::invalid_state};
+
+    const Error e = detail::enable_zerocopy(detail::native_fd(impl_->sock));
+    if (e)
+      return e;
+
+    impl_->zero_copy = true;
+    impl_->zc_armed = true;
+    return Error{ErrorCode::none};
+  }
+
+  bool Socket::zero_copy() const noexcept
+  {
+    return impl_ && impl_->zero_copy;
+  }
+
+  void Socket::set_timeout(std::chrono::milliseconds timeout) noexcept
+  {
+    if (impl_)
+      impl_->timeout = timeout;
+  }
+
+  std::chrono::milliseconds Socket::timeout() const noexcept
+  {
+    return impl_ ? impl_->timeout : std::chrono::milliseconds{0};
   }
 
   void Socket::close() noexcept
@@ -353,6 +1436,14 @@ namespace vix::net_corosio
     if (!impl_)
       return;
 
+    // Parked readiness waits must let go of the fd before it is reused.
+    if (impl_->ctx)
+    {
+      const int fd = detail::native_fd(impl_->sock);
+      if (fd >= 0)
+        detail::ContextAccess::readiness(*impl_->ctx).cancel_fd(fd);
+    }
+
     try
     {
       impl_->sock.close();
@@ -362,6 +1453,7 @@ namespace vix::net_corosio
     }
 
     impl_->st = SocketState::closed;
+    impl_->reset_zero_copy();
   }
 
   void *Socket::native_handle() noexcept
@@ -378,6 +1470,20 @@ namespace vix::net_corosio
     return static_cast<const void *>(&(impl_->sock));
   }
 
+  void Socket::mark_connected() noexcept
+  {
+    if (!impl_)
+      return;
+
+    impl_->st = SocketState::connected;
+    (void)impl_->apply_options();
+  }
+
+  Context *Socket::context() noexcept
+  {
+    return impl_ ? impl_->ctx : nullptr;
+  }
+
   void *Socket::io_context_handle() noexcept
   {
     if (!impl_ || !impl_->ioc)
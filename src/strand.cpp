@@ -0,0 +1,217 @@
+#include <vix/net_corosio/strand.hpp>
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace vix::net_corosio
+{
+  namespace detail
+  {
+    namespace
+    {
+      // Strand whose work the current thread is running, if any.
+      thread_local const StrandState *tls_current_strand = nullptr;
+    } // namespace
+
+    /**
+     * @brief Queue and ownership flag shared by all copies of a Strand.
+     *
+     * `locked` is held by whoever is allowed to run strand work: either a
+     * scheduled drain or an inline dispatch. A non-empty queue always has an
+     * owner that will look at it again before releasing.
+     */
+    class StrandState final : public std::enable_shared_from_this<StrandState>
+    {
+    public:
+      explicit StrandState(Executor ex) noexcept
+          : ex_(std::move(ex))
+      {
+      }
+
+      StrandState(const StrandState &) = delete;
+      StrandState &operator=(const StrandState &) = delete;
+
+      ~StrandState()
+      {
+        WorkItem *w = head_.exchange(nullptr, std::memory_order_acquire);
+        while (w)
+        {
+          WorkItem *next = w->next;
+          w->complete(w, false);
+          w = next;
+        }
+      }
+
+      const Executor &executor() const noexcept { return ex_; }
+
+      bool running_in_this_thread() const noexcept
+      {
+        return tls_current_strand == this;
+      }
+
+      void submit(WorkItem *work)
+      {
+        WorkItem *old = head_.load(std::memory_order_relaxed);
+        do
+        {
+          work->next = old;
+        } while (!head_.compare_exchange_weak(old, work,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+
+        if (old != nullptr)
+          return;
+
+        // Pairs with the fences in drain()/release(); see Scheduler::submit.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (locked_.exchange(true, std::memory_order_acq_rel))
+          return;
+
+        schedule_drain();
+      }
+
+      bool try_enter() noexcept
+      {
+        if (!ex_.running_in_this_thread())
+          return false;
+
+        if (locked_.exchange(true, std::memory_order_acq_rel))
+          return false;
+
+        prev_ = tls_current_strand;
+        tls_current_strand = this;
+        return true;
+      }
+
+      void leave() noexcept
+      {
+        tls_current_strand = prev_;
+        release();
+      }
+
+    private:
+      void schedule_drain()
+      {
+        auto self = shared_from_this();
+        ex_.post([self = std::move(self)]
+                 { self->drain(); });
+      }
+
+      void drain() noexcept
+      {
+        const StrandState *prev = tls_current_strand;
+        tls_current_strand = this;
+
+        for (;;)
+        {
+          WorkItem *batch = reverse(head_.exchange(nullptr, std::memory_order_acquire));
+
+          while (batch)
+          {
+            WorkItem *next = batch->next;
+            batch->complete(batch, true);
+            batch = next;
+          }
+
+          locked_.store(false, std::memory_order_release);
+
+          // Without the fence the re-check may pass the store and miss a
+          // push that saw the strand as still locked.
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          if (head_.load(std::memory_order_acquire) == nullptr)
+            break;
+
+          if (locked_.exchange(true, std::memory_order_acq_rel))
+            break;
+        }
+
+        tls_current_strand = prev;
+      }
+
+      // Drop ownership; if work arrived meanwhile, re-take it and drain later.
+      void release() noexcept
+      {
+        locked_.store(false, std::memory_order_release);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (head_.load(std::memory_order_acquire) == nullptr)
+          return;
+
+        if (locked_.exchange(true, std::memory_order_acq_rel))
+          return;
+
+        try
+        {
+          schedule_drain();
+        }
+        catch (...)
+        {
+          locked_.store(false, std::memory_order_release);
+        }
+      }
+
+      static WorkItem *reverse(WorkItem *list) noexcept
+      {
+        WorkItem *out = nullptr;
+        while (list)
+        {
+          WorkItem *next = list->next;
+          list->next = out;
+          out = list;
+          list = next;
+        }
+        return out;
+      }
+
+      Executor ex_;
+      std::atomic<WorkItem *> head_{nullptr};
+      std::atomic<bool> locked_{false};
+
+      // Only touched by the thread holding `locked_` inline.
+      const StrandState *prev_{nullptr};
+    };
+  } // namespace detail
+
+  Strand::Strand(Executor ex)
+      : state_(std::make_shared<detail::StrandState>(std::move(ex)))
+  {
+  }
+
+  const Executor &Strand::get_executor() const noexcept
+  {
+    static const Executor none{};
+    return state_ ? state_->executor() : none;
+  }
+
+  bool Strand::running_in_this_thread() const noexcept
+  {
+    return state_ && state_->running_in_this_thread();
+  }
+
+  void Strand::submit(detail::WorkItem *work)
+  {
+    // Moved-from strand: same policy as an invalid Executor.
+    if (!state_)
+    {
+      work->complete(work, false);
+      return;
+    }
+
+    state_->submit(work);
+  }
+
+  bool Strand::try_enter() noexcept
+  {
+    return state_ && state_->try_enter();
+  }
+
+  void Strand::leave() noexcept
+  {
+    if (state_)
+      state_->leave();
+  }
+
+} // namespace vix::net_corosio
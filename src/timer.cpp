@@ -0,0 +1,438 @@
+#include <vix/net_corosio/timer.hpp>
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/executor.hpp>
+
+#include <boost/corosio.hpp>
+#include <boost/capy/task.hpp>
+
+#include "detail/context_access.hpp"
+#include "detail/frame_pool.hpp"
+#include "detail/run_blocking.hpp"
+#include "detail/timer_service.hpp"
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <thread>
+#include <utility>
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+
+namespace vix::net_corosio
+{
+  namespace detail
+  {
+    TimerService::TimerService(corosio::io_context &ioc) noexcept
+        : ioc_(ioc), epoch_(clock::now())
+    {
+    }
+
+    std::uint64_t TimerService::tick_floor(clock::time_point t) const noexcept
+    {
+      if (t <= epoch_)
+        return 0;
+
+      return static_cast<std::uint64_t>(
+          std::chrono::floor<std::chrono::milliseconds>(t - epoch_).count());
+    }
+
+    std::uint64_t TimerService::tick_ceil(clock::time_point t) const noexcept
+    {
+      if (t <= epoch_)
+        return 0;
+
+      return static_cast<std::uint64_t>(
+          std::chrono::ceil<std::chrono::milliseconds>(t - epoch_).count());
+    }
+
+    void TimerService::schedule(TimerNode &n, clock::time_point at)
+    {
+      bool start = false;
+      bool poke = false;
+
+      {
+        std::lock_guard<std::mutex> lock(mu_);
+
+        // An idle wheel is not kept up to date; catch up before inserting.
+        if (wheel_.empty())
+          (void)wheel_.advance(tick_floor(clock::now()));
+
+        n.state.store(TimerNode::armed, std::memory_order_relaxed);
+        wheel_.insert(n, tick_ceil(at));
+
+        if (!sleeping_)
+        {
+          sleeping_ = true;
+          start = true;
+        }
+        else if (n.due < sleeper_due_ && sleeper_due_ != no_sleeper && !retarget_pending_)
+        {
+          retarget_pending_ = true;
+          poke = true;
+        }
+      }
+
+      if (start)
+        start_sleeper();
+      else if (poke)
+        post_retarget();
+    }
+
+    bool TimerService::cancel(TimerNode &n) noexcept
+    {
+      bool poke = false;
+
+      {
+        std::lock_guard<std::mutex> lock(mu_);
+
+        if (!n.linked())
+          return false;
+
+        wheel_.remove(n);
+        n.state.store(TimerNode::idle, std::memory_order_release);
+
+        // Last timer gone: release the backend wait so run() can return.
+        if (wheel_.empty() && sleeper_due_ != no_sleeper && !retarget_pending_)
+        {
+          retarget_pending_ = true;
+          poke = true;
+        }
+      }
+
+      if (poke)
+        post_retarget();
+
+      return true;
+    }
+
+    std::size_t TimerService::size() const noexcept
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      return wheel_.size();
+    }
+
+    std::uint64_t TimerService::next_check() const noexcept
+    {
+      return wheel_.current() + wheel_.ticks_until_next_check();
+    }
+
+    bool TimerService::needs_retarget() const noexcept
+    {
+      if (!sleeping_ || sleeper_due_ == no_sleeper)
+        return false;
+
+      return wheel_.empty() || next_check() < sleeper_due_;
+    }
+
+    void TimerService::start_sleeper()
+    {
+      try
+      {
+        launcher(ioc_.get_executor())(sleep());
+      }
+      catch (...)
+      {
+        // Let the next schedule() try again.
+        std::lock_guard<std::mutex> lock(mu_);
+        sleeping_ = false;
+      }
+    }
+
+    void TimerService::post_retarget() noexcept
+    {
+      try
+      {
+        launcher(ioc_.get_executor())(retarget());
+      }
+      catch (...)
+      {
+        // The sleeper still wakes at its old due time and catches up then.
+        std::lock_guard<std::mutex> lock(mu_);
+        retarget_pending_ = false;
+      }
+    }
+
+    capy::task<void> TimerService::retarget()
+    {
+      bool again = false;
+
+      {
+        std::lock_guard<std::mutex> lock(mu_);
+
+        // Cancelling under the lock keeps the sleeper's frame, and with it
+        // the backend timer, alive; the backend never resumes inline.
+        if (needs_retarget() && backend_)
+        {
+          try
+          {
+            backend_->cancel();
+          }
+          catch (...)
+          {
+          }
+
+          // A cancel that lands before the wait is registered is lost; run
+          // again until the sleeper has caught up.
+          again = true;
+        }
+        else
+        {
+          retarget_pending_ = false;
+        }
+      }
+
+      if (again)
+        post_retarget();
+
+      co_return;
+    }
+
+    capy::task<void> TimerService::sleep()
+    {
+      corosio::timer backend(ioc_);
+
+      for (;;)
+      {
+        std::uint64_t target = 0;
+
+        {
+          std::lock_guard<std::mutex> lock(mu_);
+
+          if (wheel_.empty())
+          {
+            sleeping_ = false;
+            sleeper_due_ = no_sleeper;
+            backend_ = nullptr;
+            break;
+          }
+
+          target = next_check();
+          sleeper_due_ = target;
+          backend_ = &backend;
+        }
+
+        const auto wake_at = epoch_ + std::chrono::milliseconds(target);
+        const auto now = clock::now();
+
+        if (wake_at > now)
+        {
+          try
+          {
+            backend.expires_after(wake_at - now);
+            (void)co_await backend.wait();
+          }
+          catch (...)
+          {
+            // Fall through: a spurious wakeup only costs one extra check.
+          }
+        }
+
+        TimerNode *expired = nullptr;
+
+        {
+          std::lock_guard<std::mutex> lock(mu_);
+
+          sleeper_due_ = no_sleeper;
+
+          expired = wheel_.advance(tick_floor(clock::now()));
+          for (TimerNode *n = expired; n; n = n->next)
+            n->state.store(TimerNode::firing, std::memory_order_relaxed);
+        }
+
+        fire_all(expired);
+      }
+    }
+
+    void TimerService::fire_all(TimerNode *expired) noexcept
+    {
+      while (expired)
+      {
+        TimerNode *next = expired->next;
+        expired->next = nullptr;
+
+        expired->fire(expired);
+
+        // Last touch: the owner may be destroyed as soon as it sees idle.
+        expired->state.store(TimerNode::idle, std::memory_order_release);
+        expired = next;
+      }
+    }
+  } // namespace detail
+
+  struct Timer::Impl final
+  {
+    Context *ctx{nullptr};
+    Executor ex{};
+    detail::TimerService *svc{nullptr};
+    detail::TimerNode node{};
+    time_point expiry{};
+
+    std::coroutine_handle<> waiter{};
+    Error result{};
+
+    explicit Impl(Context &c)
+        : ctx(&c),
+          ex(c.get_executor()),
+          svc(&detail::ContextAccess::timers(c))
+    {
+      node.fire = &Impl::on_fire;
+      node.user = this;
+    }
+
+    static void on_fire(detail::TimerNode *n) noexcept
+    {
+      static_cast<Impl *>(n->user)->complete(Error{ErrorCode::none});
+    }
+
+    // Resume the waiter through the executor, never inline: the wheel may be
+    // firing a whole batch, and the waiter may destroy this timer.
+    void complete(Error e) noexcept
+    {
+      result = e;
+      std::coroutine_handle<> h = std::exchange(waiter, std::coroutine_handle<>{});
+
+      if (!h)
+        return;
+
+      try
+      {
+        ex.post([h]
+                { h.resume(); });
+      }
+      catch (...)
+      {
+        h.resume();
+      }
+    }
+
+    void wait_fired() const noexcept
+    {
+      while (node.state.load(std::memory_order_acquire) == detail::TimerNode::firing)
+        std::this_thread::yield();
+    }
+
+    struct WaitAwaiter final
+    {
+      Impl &t;
+
+      bool await_ready() const noexcept { return false; }
+
+      template <class... Env>
+      void await_suspend(std::coroutine_handle<> h, Env &&...)
+      {
+        t.waiter = h;
+        t.svc->schedule(t.node, t.expiry);
+      }
+
+      Error await_resume() const noexcept { return t.result; }
+    };
+  };
+
+  Timer::Timer(Context &ctx)
+      : impl_(new Impl(ctx))
+  {
+  }
+
+  Timer::Timer(Timer &&other) noexcept
+      : impl_(other.impl_)
+  {
+    other.impl_ = nullptr;
+  }
+
+  Timer &Timer::operator=(Timer &&other) noexcept
+  {
+    if (this != &other)
+    {
+      (void)cancel();
+      if (impl_)
+        impl_->wait_fired();
+
+      delete impl_;
+      impl_ = other.impl_;
+      other.impl_ = nullptr;
+    }
+    return *this;
+  }
+
+  Timer::~Timer()
+  {
+    if (impl_)
+    {
+      (void)cancel();
+      impl_->wait_fired();
+      delete impl_;
+      impl_ = nullptr;
+    }
+  }
+
+  std::size_t Timer::expires_after(duration d)
+  {
+    return expires_at(clock::now() + d);
+  }
+
+  std::size_t Timer::expires_at(time_point t)
+  {
+    if (!impl_)
+      return 0;
+
+    const std::size_t n = cancel();
+    impl_->expiry = t;
+    return n;
+  }
+
+  Timer::time_point Timer::expiry() const noexcept
+  {
+    return impl_ ? impl_->expiry : time_point{};
+  }
+
+  Error Timer::wait()
+  {
+    if (!impl_ || !impl_->ctx)
+      return Error{ErrorCode::not_initialized};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_wait(); });
+  }
+
+  Task<Error> Timer::async_wait()
+  {
+    if (!impl_ || !impl_->svc)
+      co_return Error{ErrorCode::not_initialized};
+
+    // A wait that just expired may still be leaving the wheel.
+    impl_->wait_fired();
+
+    if (impl_->node.state.load(std::memory_order_acquire) != detail::TimerNode::idle)
+      co_return Error{ErrorCode::invalid_state};
+
+    if (impl_->expiry <= clock::now())
+      co_return Error{ErrorCode::none};
+
+    Error out{ErrorCode::unknown};
+
+    try
+    {
+      out = co_await Impl::WaitAwaiter{*impl_};
+    }
+    catch (...)
+    {
+      out = Error{ErrorCode::unknown};
+    }
+
+    co_return out;
+  }
+
+  std::size_t Timer::cancel() noexcept
+  {
+    if (!impl_ || !impl_->svc)
+      return 0;
+
+    if (!impl_->svc->cancel(impl_->node))
+      return 0;
+
+    impl_->complete(Error{ErrorCode::canceled});
+    return 1;
+  }
+
+} // namespace vix::net_corosio
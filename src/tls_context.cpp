@@ -2,9 +2,12 @@
 
 #include <boost/corosio/tls_context.hpp>
 
+#include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace corosio = boost::corosio;
 
@@ -128,6 +131,10 @@ namespace vix::net_corosio
     TlsRole r{TlsRole::client};
     corosio::tls_context ctx{};
 
+    // Identity settings, kept for hostname()/alpn().
+    std::string hostname{};
+    std::vector<std::string> alpn{};
+
     explicit Impl(TlsRole role)
         : r(role), ctx()
     {
@@ -186,10 +193,25 @@ namespace vix::net_corosio
     if (hostname.empty())
       return Error{ErrorCode::invalid_argument};
 
-    return detail::call_and_map(
+    const Error e = detail::call_and_map(
         [&]
         { impl_->ctx.set_hostname(std::string(hostname)); },
         ErrorCode::invalid_argument);
+
+    if (!e)
+      impl_->hostname = std::string(hostname);
+
+    return e;
+  }
+
+  std::string_view TlsContext::hostname() const noexcept
+  {
+    return impl_ ? std::string_view(impl_->hostname) : std::string_view{};
+  }
+
+  std::span<const std::string> TlsContext::alpn() const noexcept
+  {
+    return impl_ ? std::span<const std::string>(impl_->alpn) : std::span<const std::string>{};
   }
 
   Error TlsContext::set_default_verify_paths()
@@ -286,28 +308,36 @@ namespace vix::net_corosio
       return i < protocols.size() && std::string_view(protocols[i]) == v;
     };
 
+    // Remembered on success; see alpn().
+    const auto remember = [&](Error e)
+    {
+      if (!e)
+        impl_->alpn = protocols;
+      return e;
+    };
+
     if (protocols.size() == 1 && is(0, "h2"))
     {
-      return detail::call_and_map([&]
-                                  { return impl_->ctx.set_alpn({"h2"}); }, ErrorCode::invalid_argument);
+      return remember(detail::call_and_map([&]
+                                    { return impl_->ctx.set_alpn({"h2"}); }, ErrorCode::invalid_argument));
     }
 
     if (protocols.size() == 1 && is(0, "http/1.1"))
     {
-      return detail::call_and_map([&]
-                                  { return impl_->ctx.set_alpn({"http/1.1"}); }, ErrorCode::invalid_argument);
+      return remember(detail::call_and_map([&]
+                                    { return impl_->ctx.set_alpn({"http/1.1"}); }, ErrorCode::invalid_argument));
     }
 
     if (protocols.size() == 2 && is(0, "h2") && is(1, "http/1.1"))
     {
-      return detail::call_and_map([&]
-                                  { return impl_->ctx.set_alpn({"h2", "http/1.1"}); }, ErrorCode::invalid_argument);
+      return remember(detail::call_and_map([&]
+                                    { return impl_->ctx.set_alpn({"h2", "http/1.1"}); }, ErrorCode::invalid_argument));
     }
 
     if (protocols.size() == 2 && is(0, "http/1.1") && is(1, "h2"))
     {
-      return detail::call_and_map([&]
-                                  { return impl_->ctx.set_alpn({"http/1.1", "h2"}); }, ErrorCode::invalid_argument);
+      return remember(detail::call_and_map([&]
+                                    { return impl_->ctx.set_alpn({"http/1.1", "h2"}); }, ErrorCode::invalid_argument));
     }
 
     return Error{ErrorCode::invalid_argument};
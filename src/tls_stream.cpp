@@ -2,11 +2,15 @@
 
 #include <boost/corosio.hpp>
 #include <boost/capy/buffers.hpp>
-#include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/task.hpp>
-#include <boost/capy/write.hpp>
 
-#include <atomic>
+#include "detail/buffer_seq.hpp"
+#include "detail/composed.hpp"
+#include "detail/context_access.hpp"
+#include "detail/deadline_guard.hpp"
+#include "detail/run_blocking.hpp"
+
+#include <chrono>
 #include <exception>
 #include <system_error>
 #include <type_traits>
@@ -92,6 +96,7 @@ namespace vix::net_corosio
 
     corosio::tcp_socket *sock{nullptr};
     corosio::io_context *ioc{nullptr};
+    Context *ctx{nullptr};
 
 #if VIX_NET_COROSIO_TLS_BACKEND_WOLFSSL
     using NativeStream = corosio::wolfssl_stream;
@@ -106,11 +111,34 @@ namespace vix::net_corosio
           ctx_wrap(&c),
           sock(static_cast<corosio::tcp_socket *>(s.native_handle())),
           ioc(static_cast<corosio::io_context *>(s.io_context_handle())),
+          ctx(s.context()),
           stream(
               sock,
               *static_cast<corosio::tls_context *>(c.native_handle()))
     {
     }
+
+    // The underlying socket's default timeout.
+    std::chrono::milliseconds timeout() const noexcept
+    {
+      return sock_wrap ? sock_wrap->timeout() : std::chrono::milliseconds{0};
+    }
+
+    // Arm guard for one operation. Returns false if the deadline already passed.
+    bool arm(const Deadline &d, detail::DeadlineGuard &guard)
+    {
+      const auto when = detail::effective_deadline(d, timeout());
+      if (!when || !ctx || !sock)
+        return true;
+
+      if (*when <= Deadline::clock::now())
+        return false;
+
+      // Cancelling the TCP socket fails whatever TLS step is waiting on it.
+      guard.arm(detail::ContextAccess::timers(*ctx), *when,
+                &detail::cancel_io<corosio::tcp_socket>, sock);
+      return true;
+    }
   };
 
   TlsStream::TlsStream(Socket &socket, TlsContext &ctx)
@@ -145,61 +173,134 @@ namespace vix::net_corosio
     }
   }
 
-  Error TlsStream::handshake()
+  Error TlsStream::handshake(Deadline deadline)
   {
-    if (!impl_ || !impl_->sock || !impl_->ioc || !impl_->ctx_wrap)
+    if (!impl_ || !impl_->sock || !impl_->ioc || !impl_->ctx || !impl_->ctx_wrap)
       return Error{ErrorCode::not_initialized};
 
-    std::atomic<bool> done{false};
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_handshake(deadline); });
+  }
+
+  TlsIoResult TlsStream::read_some(void *data, std::size_t size, Deadline deadline)
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc || !impl_->ctx)
+      return TlsIoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_read_some(data, size, deadline); });
+  }
+
+  TlsIoResult TlsStream::write_some(const void *data, std::size_t size, Deadline deadline)
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc || !impl_->ctx)
+      return TlsIoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_write_some(data, size, deadline); });
+  }
+
+  TlsIoResult TlsStream::read_some(std::span<const MutableBuffer> buffers, Deadline deadline)
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc || !impl_->ctx)
+      return TlsIoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_read_some(buffers, deadline); });
+  }
+
+  TlsIoResult TlsStream::write_some(std::span<const ConstBuffer> buffers, Deadline deadline)
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc || !impl_->ctx)
+      return TlsIoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_write_some(buffers, deadline); });
+  }
+
+  TlsIoResult TlsStream::write_all(const void *data, std::size_t size, Deadline deadline)
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc || !impl_->ctx)
+      return TlsIoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_write_all(data, size, deadline); });
+  }
+
+  TlsIoResult TlsStream::write_all(std::span<const ConstBuffer> buffers, Deadline deadline)
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc || !impl_->ctx)
+      return TlsIoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_write_all(buffers, deadline); });
+  }
+
+  TlsIoResult TlsStream::read_exact(void *data, std::size_t size, Deadline deadline)
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc || !impl_->ctx)
+      return TlsIoResult{Error{ErrorCode::not_initialized}, 0};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_read_exact(data, size, deadline); });
+  }
+
+  Error TlsStream::shutdown()
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc || !impl_->ctx)
+      return Error{ErrorCode::not_initialized};
+
+    return detail::run_blocking(*impl_->ctx, [&]
+                                { return async_shutdown(); });
+  }
+
+  Task<Error> TlsStream::async_handshake(Deadline deadline)
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc || !impl_->ctx_wrap)
+      co_return Error{ErrorCode::not_initialized};
+
+    detail::DeadlineGuard guard;
+    if (!impl_->arm(deadline, guard))
+      co_return Error{ErrorCode::timeout};
+
     Error out{ErrorCode::unknown};
 
-    auto task = [&]() -> capy::task<void>
+    try
     {
-      try
-      {
 #if VIX_NET_COROSIO_TLS_BACKEND_WOLFSSL
-        auto mode = (impl_->ctx_wrap->role() == TlsRole::server)
-                        ? corosio::wolfssl_stream::server
-                        : corosio::wolfssl_stream::client;
+      auto mode = (impl_->ctx_wrap->role() == TlsRole::server)
+                      ? corosio::wolfssl_stream::server
+                      : corosio::wolfssl_stream::client;
 
-        auto r = co_await impl_->stream.handshake(mode);
+      auto r = co_await impl_->stream.handshake(mode);
 #else
-        auto mode = (impl_->ctx_wrap->role() == TlsRole::server)
-                        ? corosio::tls_stream::server
-                        : corosio::tls_stream::client;
+      auto mode = (impl_->ctx_wrap->role() == TlsRole::server)
+                      ? corosio::tls_stream::server
+                      : corosio::tls_stream::client;
 
-        auto r = co_await impl_->stream.handshake(mode);
+      auto r = co_await impl_->stream.handshake(mode);
 #endif
 
-        const auto ec = detail::io_error(r);
-        if (ec)
-        {
-          out = Error{map_tls_error(ec, ErrorCode::tls_handshake_failed)};
-          done.store(true, std::memory_order_release);
-          co_return;
-        }
+      guard.disarm();
+      const auto ec = detail::io_error(r);
 
-        out = Error{ErrorCode::none};
-      }
-      catch (...)
-      {
-        out = Error{ErrorCode::unknown};
-      }
-
-      done.store(true, std::memory_order_release);
-    };
+      if (ec && guard.expired())
+        co_return Error{ErrorCode::timeout};
 
-    capy::run_async(impl_->ioc->get_executor())(task());
+      if (ec)
+        co_return Error{map_tls_error(ec, ErrorCode::tls_handshake_failed)};
 
-    while (!done.load(std::memory_order_acquire))
+      out = Error{ErrorCode::none};
+    }
+    catch (...)
     {
-      impl_->ioc->run_one();
+      out = Error{ErrorCode::unknown};
     }
 
-    return out;
+    co_return out;
   }
 
-  TlsIoResult TlsStream::read_some(void *data, std::size_t size)
+  Task<TlsIoResult> TlsStream::async_read_some(void *data, std::size_t size, Deadline deadline)
   {
     TlsIoResult out{};
     out.error = Error{ErrorCode::unknown};
@@ -208,55 +309,55 @@ namespace vix::net_corosio
     if (!impl_ || !impl_->sock || !impl_->ioc)
     {
       out.error = Error{ErrorCode::not_initialized};
-      return out;
+      co_return out;
     }
 
     if (!data || size == 0)
     {
       out.error = Error{ErrorCode::invalid_argument};
-      return out;
+      co_return out;
     }
 
-    std::atomic<bool> done{false};
+    detail::DeadlineGuard guard;
+    if (!impl_->arm(deadline, guard))
+    {
+      out.error = Error{ErrorCode::timeout};
+      co_return out;
+    }
 
-    auto task = [&]() -> capy::task<void>
+    try
     {
-      try
+      auto r = co_await impl_->stream.read_some(capy::mutable_buffer(data, size));
+      guard.disarm();
+      const auto ec = detail::io_error(r);
+
+      if (ec && guard.expired())
       {
-        auto r = co_await impl_->stream.read_some(capy::mutable_buffer(data, size));
-        const auto ec = detail::io_error(r);
-
-        if (ec)
-        {
-          out.error = Error{map_tls_error(ec, ErrorCode::read_failed)};
-          out.bytes = 0;
-          done.store(true, std::memory_order_release);
-          co_return;
-        }
-
-        out.error = Error{ErrorCode::none};
-        out.bytes = detail::io_bytes(r);
+        out.error = Error{ErrorCode::timeout};
+        out.bytes = 0;
+        co_return out;
       }
-      catch (...)
+
+      if (ec)
       {
-        out.error = Error{ErrorCode::unknown};
+        out.error = Error{map_tls_error(ec, ErrorCode::read_failed)};
         out.bytes = 0;
+        co_return out;
       }
 
-      done.store(true, std::memory_order_release);
-    };
-
-    capy::run_async(impl_->ioc->get_executor())(task());
-
-    while (!done.load(std::memory_order_acquire))
+      out.error = Error{ErrorCode::none};
+      out.bytes = detail::io_bytes(r);
+    }
+    catch (...)
     {
-      impl_->ioc->run_one();
+      out.error = Error{ErrorCode::unknown};
+      out.bytes = 0;
     }
 
-    return out;
+    co_return out;
   }
 
-  TlsIoResult TlsStream::write_some(const void *data, std::size_t size)
+  Task<TlsIoResult> TlsStream::async_write_some(const void *data, std::size_t size, Deadline deadline)
   {
     TlsIoResult out{};
     out.error = Error{ErrorCode::unknown};
@@ -265,94 +366,233 @@ namespace vix::net_corosio
     if (!impl_ || !impl_->sock || !impl_->ioc)
     {
       out.error = Error{ErrorCode::not_initialized};
-      return out;
+      co_return out;
     }
 
     if (!data || size == 0)
     {
       out.error = Error{ErrorCode::invalid_argument};
-      return out;
+      co_return out;
     }
 
-    std::atomic<bool> done{false};
+    detail::DeadlineGuard guard;
+    if (!impl_->arm(deadline, guard))
+    {
+      out.error = Error{ErrorCode::timeout};
+      co_return out;
+    }
 
-    auto task = [&]() -> capy::task<void>
+    try
     {
-      try
+      auto r = co_await impl_->stream.write_some(capy::const_buffer(data, size));
+      guard.disarm();
+      const auto ec = detail::io_error(r);
+
+      if (ec && guard.expired())
       {
-        auto r = co_await capy::write(impl_->stream, capy::const_buffer(data, size));
-        const auto ec = detail::io_error(r);
-
-        if (ec)
-        {
-          out.error = Error{map_tls_error(ec, ErrorCode::write_failed)};
-          out.bytes = 0;
-          done.store(true, std::memory_order_release);
-          co_return;
-        }
-
-        out.error = Error{ErrorCode::none};
-        out.bytes = detail::io_bytes(r);
+        out.error = Error{ErrorCode::timeout};
+        out.bytes = 0;
+        co_return out;
       }
-      catch (...)
+
+      if (ec)
       {
-        out.error = Error{ErrorCode::unknown};
+        out.error = Error{map_tls_error(ec, ErrorCode::write_failed)};
         out.bytes = 0;
+        co_return out;
       }
 
-      done.store(true, std::memory_order_release);
-    };
+      out.error = Error{ErrorCode::none};
+      out.bytes = detail::io_bytes(r);
+    }
+    catch (...)
+    {
+      out.error = Error{ErrorCode::unknown};
+      out.bytes = 0;
+    }
+
+    co_return out;
+  }
 
-    capy::run_async(impl_->ioc->get_executor())(task());
+  Task<TlsIoResult> TlsStream::async_read_some(std::span<const MutableBuffer> buffers, Deadline deadline)
+  {
+    TlsIoResult out{};
+    out.error = Error{ErrorCode::unknown};
+    out.bytes = 0;
 
-    while (!done.load(std::memory_order_acquire))
+    if (!impl_ || !impl_->sock || !impl_->ioc)
     {
-      impl_->ioc->run_one();
+      out.error = Error{ErrorCode::not_initialized};
+      co_return out;
+    }
+
+    if (buffer_size(buffers) == 0)
+    {
+      out.error = Error{ErrorCode::invalid_argument};
+      co_return out;
+    }
+
+    detail::DeadlineGuard guard;
+    if (!impl_->arm(deadline, guard))
+    {
+      out.error = Error{ErrorCode::timeout};
+      co_return out;
+    }
+
+    try
+    {
+      detail::SmallArray<capy::mutable_buffer> seq(buffers.size());
+      detail::to_backend(buffers, 0, seq);
+
+      auto r = co_await impl_->stream.read_some(seq.span());
+      guard.disarm();
+      const auto ec = detail::io_error(r);
+
+      if (ec && guard.expired())
+      {
+        out.error = Error{ErrorCode::timeout};
+        out.bytes = 0;
+        co_return out;
+      }
+
+      if (ec)
+      {
+        out.error = Error{map_tls_error(ec, ErrorCode::read_failed)};
+        out.bytes = 0;
+        co_return out;
+      }
+
+      out.error = Error{ErrorCode::none};
+      out.bytes = detail::io_bytes(r);
+    }
+    catch (...)
+    {
+      out.error = Error{ErrorCode::unknown};
+      out.bytes = 0;
     }
 
-    return out;
+    co_return out;
   }
 
-  Error TlsStream::shutdown()
+  Task<TlsIoResult> TlsStream::async_write_some(std::span<const ConstBuffer> buffers, Deadline deadline)
   {
+    TlsIoResult out{};
+    out.error = Error{ErrorCode::unknown};
+    out.bytes = 0;
+
     if (!impl_ || !impl_->sock || !impl_->ioc)
-      return Error{ErrorCode::not_initialized};
+    {
+      out.error = Error{ErrorCode::not_initialized};
+      co_return out;
+    }
 
-    std::atomic<bool> done{false};
-    Error out{ErrorCode::unknown};
+    if (buffer_size(buffers) == 0)
+    {
+      out.error = Error{ErrorCode::invalid_argument};
+      co_return out;
+    }
 
-    auto task = [&]() -> capy::task<void>
+    detail::DeadlineGuard guard;
+    if (!impl_->arm(deadline, guard))
     {
-      try
-      {
-        auto r = co_await impl_->stream.shutdown();
-        const auto ec = detail::io_error(r);
+      out.error = Error{ErrorCode::timeout};
+      co_return out;
+    }
+
+    try
+    {
+      detail::SmallArray<capy::const_buffer> seq(buffers.size());
+      detail::to_backend(buffers, 0, seq);
 
-        if (ec)
-        {
-          out = Error{map_tls_error(ec, ErrorCode::tls_shutdown_failed)};
-          done.store(true, std::memory_order_release);
-          co_return;
-        }
+      auto r = co_await impl_->stream.write_some(seq.span());
+      guard.disarm();
+      const auto ec = detail::io_error(r);
 
-        out = Error{ErrorCode::none};
+      if (ec && guard.expired())
+      {
+        out.error = Error{ErrorCode::timeout};
+        out.bytes = 0;
+        co_return out;
       }
-      catch (...)
+
+      if (ec)
       {
-        out = Error{ErrorCode::unknown};
+        out.error = Error{map_tls_error(ec, ErrorCode::write_failed)};
+        out.bytes = 0;
+        co_return out;
       }
 
-      done.store(true, std::memory_order_release);
-    };
+      out.error = Error{ErrorCode::none};
+      out.bytes = detail::io_bytes(r);
+    }
+    catch (...)
+    {
+      out.error = Error{ErrorCode::unknown};
+      out.bytes = 0;
+    }
+
+    co_return out;
+  }
+
+  Task<TlsIoResult> TlsStream::async_write_all(const void *data, std::size_t size, Deadline deadline)
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc)
+      co_return TlsIoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (!data || size == 0)
+      co_return TlsIoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    const auto d = detail::composed_deadline(deadline, impl_->timeout());
+    co_return co_await detail::write_all<TlsIoResult>(*this, data, size, d);
+  }
+
+  Task<TlsIoResult> TlsStream::async_write_all(std::span<const ConstBuffer> buffers, Deadline deadline)
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc)
+      co_return TlsIoResult{Error{ErrorCode::not_initialized}, 0};
+
+    if (buffer_size(buffers) == 0)
+      co_return TlsIoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    const auto d = detail::composed_deadline(deadline, impl_->timeout());
+    co_return co_await detail::write_all<TlsIoResult>(*this, buffers, d);
+  }
 
-    capy::run_async(impl_->ioc->get_executor())(task());
+  Task<TlsIoResult> TlsStream::async_read_exact(void *data, std::size_t size, Deadline deadline)
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc)
+      co_return TlsIoResult{Error{ErrorCode::not_initialized}, 0};
 
-    while (!done.load(std::memory_order_acquire))
+    if (!data || size == 0)
+      co_return TlsIoResult{Error{ErrorCode::invalid_argument}, 0};
+
+    const auto d = detail::composed_deadline(deadline, impl_->timeout());
+    co_return co_await detail::read_exact<TlsIoResult>(*this, data, size, d);
+  }
+
+  Task<Error> TlsStream::async_shutdown()
+  {
+    if (!impl_ || !impl_->sock || !impl_->ioc)
+      co_return Error{ErrorCode::not_initialized};
+
+    Error out{ErrorCode::unknown};
+
+    try
+    {
+      auto r = co_await impl_->stream.shutdown();
+      const auto ec = detail::io_error(r);
+
+      if (ec)
+        co_return Error{map_tls_error(ec, ErrorCode::tls_shutdown_failed)};
+
+      out = Error{ErrorCode::none};
+    }
+    catch (...)
     {
-      impl_->ioc->run_one();
+      out = Error{ErrorCode::unknown};
     }
 
-    return out;
+    co_return out;
   }
 
   void TlsStream::close() noexcept
@@ -360,9 +600,13 @@ namespace vix::net_corosio
     if (!impl_)
       return;
 
+    // Nothing to send close_notify on; skip the blocking round trip.
+    const bool connected = impl_->sock_wrap && impl_->sock_wrap->state() == SocketState::connected;
+
     try
     {
-      (void)shutdown();
+      if (connected)
+        (void)shutdown();
     }
     catch (...)
     {
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vix/net_corosio/buffer.hpp>
+#include <vix/net_corosio/buffered_stream.hpp>
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/deadline.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/listener.hpp>
+#include <vix/net_corosio/socket.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace fixtures
+{
+  using namespace vix::net_corosio;
+
+  /**
+   * @brief In-memory stream counting the calls that would be syscalls.
+   *
+   * Input is handed out in chunks of at most step bytes.
+   */
+  struct FakeStream final
+  {
+    std::string input;
+    std::size_t offset{0};
+    std::size_t step{1 << 20};
+    std::string output;
+    int reads{0};
+    int writes{0};
+
+    IoResult read_some(void *data, std::size_t size, Deadline = {})
+    {
+      ++reads;
+      const std::size_t n = std::min({size, step, input.size() - offset});
+      std::memcpy(data, input.data() + offset, n);
+      offset += n;
+      return IoResult{Error{ErrorCode::none}, n};
+    }
+
+    IoResult read_exact(void *data, std::size_t size, Deadline d = {})
+    {
+      auto r = read_some(data, size, d);
+      if (r.bytes < size)
+        r.error = Error{ErrorCode::connection_closed};
+      return r;
+    }
+
+    IoResult write_all(const void *data, std::size_t size, Deadline = {})
+    {
+      ++writes;
+      output.append(static_cast<const char *>(data), size);
+      return IoResult{Error{ErrorCode::none}, size};
+    }
+
+    IoResult write_all(std::span<const ConstBuffer> buffers, Deadline = {})
+    {
+      ++writes;
+      for (const auto &b : buffers)
+        output.append(static_cast<const char *>(b.data), b.size);
+      return IoResult{Error{ErrorCode::none}, buffer_size(buffers)};
+    }
+  };
+
+  /**
+   * @brief Accept one client and send it "line <i><terminator>" for i < lines.
+   *
+   * Publishes the listening port through port, then closes after the flush.
+   */
+  inline void line_server(std::atomic<std::uint16_t> &port, int lines, std::string_view terminator)
+  {
+    Context ctx;
+
+    Listener listener(ctx);
+    if (listener.open() || listener.bind(0) || listener.listen(1))
+      std::abort();
+
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    auto accepted = listener.accept();
+    if (!accepted.ok())
+      std::abort();
+
+    BufferedStream<Socket> out(accepted.socket);
+    for (int i = 0; i < lines; ++i)
+    {
+      std::string line = "line " + std::to_string(i);
+      line += terminator;
+      auto w = out.write(line.data(), line.size());
+      assert(w.ok());
+      (void)w;
+    }
+
+    auto f = out.flush();
+    assert(f.ok());
+    (void)f;
+
+    accepted.socket.close();
+    listener.close();
+  }
+
+} // namespace fixtures
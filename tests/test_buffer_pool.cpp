@@ -0,0 +1,235 @@
+#include <vix/net_corosio/buffer_pool.hpp>
+#include <vix/net_corosio/config.hpp>
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/listener.hpp>
+#include <vix/net_corosio/socket.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace vix::net_corosio;
+
+namespace
+{
+  bool page_aligned(const void *p)
+  {
+    return reinterpret_cast<std::uintptr_t>(p) % BufferPool::min_block == 0;
+  }
+
+  void test_size_classes()
+  {
+    BufferPool pool;
+
+    auto small = pool.acquire(100);
+    assert(small && small.size() == 100 && small.capacity() == 4096);
+    assert(page_aligned(small.data()));
+
+    auto mid = pool.acquire(16 * 1024 + 1);
+    assert(mid.capacity() == 32 * 1024);
+
+    auto dflt = pool.acquire(0);
+    assert(dflt.size() == BufferPool::min_block);
+
+    // Beyond the largest class: a dedicated allocation.
+    auto big = pool.acquire(100 * 1024);
+    assert(big && big.capacity() == 100 * 1024);
+    assert(page_aligned(big.data()));
+
+    std::memset(big.data(), 0x5a, big.size());
+
+    const BufferPoolStats s = pool.stats();
+    assert(s.in_use_bytes == 4096 + 32 * 1024 + 4096 + big.capacity());
+    assert(s.idle_bytes == 0);
+    (void)s;
+
+    std::cout << "[test_buffer_pool] test_size_classes OK\n";
+  }
+
+  void test_reuse_and_stats()
+  {
+    BufferPool pool;
+
+    auto a = pool.acquire(16 * 1024);
+    char *first = a.data();
+    a.reset();
+    assert(!a);
+    assert(pool.stats().in_use_bytes == 0);
+    assert(pool.stats().idle_bytes == 16 * 1024);
+
+    // Same thread, same class: the cached block comes straight back.
+    auto b = pool.acquire(12 * 1024);
+    assert(b.data() == first);
+    assert(pool.stats().idle_bytes == 0);
+    (void)first;
+
+    PooledBuffer moved = std::move(b);
+    assert(!b && moved);
+
+    moved = PooledBuffer{};
+    assert(pool.stats().idle_bytes == 16 * 1024);
+
+    std::cout << "[test_buffer_pool] test_reuse_and_stats OK\n";
+  }
+
+  void test_cross_thread_and_trim()
+  {
+    BufferPoolOptions opts{};
+    opts.thread_cache_blocks = 2;
+    BufferPool pool(opts);
+
+    std::vector<PooledBuffer> held;
+    for (int i = 0; i < 8; ++i)
+      held.push_back(pool.acquire(8 * 1024));
+
+    // Released elsewhere: two stay in that thread's cache until it exits,
+    // then everything ends up on the shared list.
+    std::thread other([&]
+                      { held.clear(); });
+    other.join();
+
+    assert(pool.stats().in_use_bytes == 0);
+    assert(pool.stats().idle_bytes == 8 * 8 * 1024);
+
+    assert(pool.trim() == 8 * 8 * 1024);
+    assert(pool.stats().idle_bytes == 0);
+
+    std::cout << "[test_buffer_pool] test_cross_thread_and_trim OK\n";
+  }
+
+  void test_arena()
+  {
+    BufferPoolOptions opts{};
+    opts.arena_bytes = 256 * 1024;
+    opts.huge_pages = true;
+    BufferPool pool(opts);
+
+    const BufferPoolStats s = pool.stats();
+    if (s.arena_bytes == 0)
+    {
+      std::cout << "[test_buffer_pool] arena not supported, skipping\n";
+      return;
+    }
+
+    std::cout << "[test_buffer_pool] arena huge pages: " << (pool.huge_pages() ? "yes" : "no") << "\n";
+
+    std::vector<PooledBuffer> held;
+    for (int i = 0; i < 4; ++i)
+    {
+      held.push_back(pool.acquire(64 * 1024));
+      assert(held.back() && page_aligned(held.back().data()));
+      std::memset(held.back().data(), i, held.back().size());
+    }
+
+    assert(pool.stats().arena_used_bytes == 256 * 1024);
+
+    // Arena full: the next block comes from the heap.
+    auto extra = pool.acquire(64 * 1024);
+    assert(extra);
+    assert(pool.stats().arena_used_bytes == 256 * 1024);
+
+    std::thread other([&]
+                      { held.clear(); });
+    other.join();
+
+    const std::size_t released = pool.trim();
+    if (!pool.huge_pages())
+      assert(released == 4 * (64 - 4) * 1024);
+    (void)released;
+
+    // Trimmed arena blocks are still usable.
+    auto again = pool.acquire(64 * 1024);
+    assert(again);
+    std::memset(again.data(), 0x11, again.size());
+
+    std::cout << "[test_buffer_pool] test_arena OK\n";
+  }
+
+  void echo_once(std::atomic<std::uint16_t> &port)
+  {
+    Context ctx;
+
+    Listener listener(ctx);
+    if (listener.open() || listener.bind(0) || listener.listen(1))
+      std::abort();
+
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    auto accepted = listener.accept();
+    if (!accepted.ok())
+      std::abort();
+
+    PooledBuffer buf = ctx.buffer_pool().acquire(16 * 1024);
+    auto r = accepted.socket.read_some(buf.data(), buf.size());
+    assert(r.ok() && r.bytes > 0);
+
+    auto w = accepted.socket.write_all(buf.data(), r.bytes);
+    assert(w.ok());
+    (void)w;
+
+    buf.reset();
+    accepted.socket.close();
+    listener.close();
+  }
+
+  void test_context_pool_io()
+  {
+    std::atomic<std::uint16_t> port{0};
+    std::thread server([&]
+                       { echo_once(port); });
+
+    while (port.load(std::memory_order_acquire) == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    Context ctx;
+    Socket sock(ctx);
+
+    const Error e = sock.connect(TcpEndpoint{"127.0.0.1", port.load(std::memory_order_acquire)});
+    assert(!e);
+    (void)e;
+
+    {
+      PooledBuffer out = ctx.buffer_pool().acquire(5);
+      std::memcpy(out.data(), "hello", 5);
+      auto w = sock.write_some(out.data(), out.size());
+      assert(w.ok() && w.bytes == 5);
+      (void)w;
+
+      PooledBuffer in = ctx.buffer_pool().acquire(64);
+      auto r = sock.read_exact(in.data(), 5);
+      assert(r.ok());
+      assert(std::string(in.data(), 5) == "hello");
+      (void)r;
+
+      assert(ctx.buffer_pool().stats().in_use_bytes == 2 * BufferPool::min_block);
+    }
+
+    assert(ctx.buffer_pool().stats().in_use_bytes == 0);
+
+    sock.close();
+    server.join();
+
+    std::cout << "[test_buffer_pool] test_context_pool_io OK\n";
+  }
+} // namespace
+
+int main()
+{
+  test_size_classes();
+  test_reuse_and_stats();
+  test_cross_thread_and_trim();
+  test_arena();
+  test_context_pool_io();
+
+  std::cout << "[test_buffer_pool] all tests passed\n";
+  return 0;
+}
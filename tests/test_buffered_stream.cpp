@@ -0,0 +1,221 @@
+#include <vix/net_corosio/buffered_stream.hpp>
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/listener.hpp>
+#include <vix/net_corosio/ring_buffer.hpp>
+#include <vix/net_corosio/socket.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <span>
+#include <string>
+#include <thread>
+
+#include "stream_fixtures.hpp"
+
+using namespace vix::net_corosio;
+using fixtures::FakeStream;
+using fixtures::line_server;
+
+namespace
+{
+  void fill_ring(RingBuffer &ring, std::string_view text)
+  {
+    const MutableBuffer room = ring.prepare();
+    assert(room.size >= text.size());
+    std::memcpy(room.data, text.data(), text.size());
+    ring.commit(text.size());
+  }
+
+  void test_ring_compact()
+  {
+    RingBuffer ring(8);
+    assert(!ring.mirrored());
+    assert(ring.capacity() == 8);
+
+    fill_ring(ring, "abcdef");
+    ring.consume(4);
+    assert(ring.view() == "ef");
+
+    // The unread bytes move to the front so all free space is contiguous.
+    assert(ring.prepare().size == 6);
+    fill_ring(ring, "ghijkl");
+    assert(ring.full());
+    assert(ring.view() == "efghijkl");
+
+    ring.consume(8);
+    assert(ring.empty());
+
+    std::cout << "[test_buffered_stream] test_ring_compact OK\n";
+  }
+
+  void test_ring_mirrored()
+  {
+    RingBuffer ring(100, true);
+    if (!ring.mirrored())
+    {
+      std::cout << "[test_buffered_stream] mirrored ring not supported, skipping\n";
+      return;
+    }
+
+    const std::size_t cap = ring.capacity();
+    assert(cap >= 100);
+
+    // Park the head near the end, then write across the wrap point.
+    std::string head(cap - 3, 'x');
+    fill_ring(ring, head);
+    ring.consume(cap - 4);
+    assert(ring.view() == "x");
+
+    fill_ring(ring, "wrapped");
+    assert(ring.view() == "xwrapped");
+
+    std::cout << "[test_buffered_stream] test_ring_mirrored OK\n";
+  }
+
+  void test_small_reads_share_one_fill()
+  {
+    FakeStream fake;
+    for (int i = 0; i < 100; ++i)
+      fake.input += "line " + std::to_string(i) + "\n";
+
+    BufferedStream<FakeStream> in(fake);
+
+    std::string got;
+    for (;;)
+    {
+      char c = 0;
+      auto r = in.read_some(&c, 1);
+      assert(r.ok());
+      if (r.bytes == 0)
+        break;
+      got.push_back(c);
+    }
+
+    assert(got == fake.input);
+    // One fill for the data, one to see end of stream.
+    assert(fake.reads == 2);
+
+    std::cout << "[test_buffered_stream] test_small_reads_share_one_fill OK\n";
+  }
+
+  void test_peek_consume_ensure()
+  {
+    FakeStream fake;
+    fake.input = "HEAD0123456789";
+
+    BufferedStreamOptions opts{};
+    opts.read_buffer_bytes = 8;
+    BufferedStream<FakeStream> in(fake, opts);
+
+    auto e = in.ensure(4);
+    assert(e.ok());
+    assert(in.peek().substr(0, 4) == "HEAD");
+    in.consume(4);
+
+    assert(in.ensure(9).error.code == ErrorCode::invalid_argument);
+
+    char body[10]{};
+    auto r = in.read_exact(body, sizeof(body));
+    assert(r.ok() && r.bytes == sizeof(body));
+    assert(std::string(body, sizeof(body)) == "0123456789");
+
+    assert(in.read_exact(body, 1).error.code == ErrorCode::connection_closed);
+
+    std::cout << "[test_buffered_stream] test_peek_consume_ensure OK\n";
+  }
+
+  void test_write_buffer()
+  {
+    FakeStream fake;
+
+    BufferedStreamOptions opts{};
+    opts.write_buffer_bytes = 16;
+    BufferedStream<FakeStream> out(fake, opts);
+
+    for (int i = 0; i < 4; ++i)
+    {
+      auto w = out.write("abc", 3);
+      assert(w.ok() && w.bytes == 3);
+    }
+
+    assert(fake.writes == 0);
+    assert(out.pending() == 12);
+
+    // Does not fit: pending bytes and the new ones leave in one write.
+    const std::string big(32, 'z');
+    auto w = out.write(big.data(), big.size());
+    assert(w.ok() && w.bytes == big.size());
+    assert(fake.writes == 1);
+    assert(out.pending() == 0);
+
+    (void)out.write("tail", 4);
+    auto f = out.flush();
+    assert(f.ok() && f.bytes == 4);
+    assert(fake.writes == 2);
+    assert(fake.output == "abcabcabcabc" + big + "tail");
+
+    std::cout << "[test_buffered_stream] test_write_buffer OK\n";
+  }
+
+  constexpr int kLines = 200;
+
+  void test_socket_round_trip()
+  {
+    std::atomic<std::uint16_t> port{0};
+    std::thread server([&]
+                       { line_server(port, kLines, "\n"); });
+
+    while (port.load(std::memory_order_acquire) == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    Context ctx;
+    Socket sock(ctx);
+
+    const Error e = sock.connect(TcpEndpoint{"127.0.0.1", port.load(std::memory_order_acquire)});
+    assert(!e);
+    (void)e;
+
+    BufferedStream<Socket> in(sock);
+
+    std::string got;
+    for (;;)
+    {
+      char c = 0;
+      auto r = in.read_some(&c, 1);
+      assert(r.ok());
+      if (r.bytes == 0)
+        break;
+      got.push_back(c);
+    }
+
+    std::string want;
+    for (int i = 0; i < kLines; ++i)
+      want += "line " + std::to_string(i) + "\n";
+    assert(got == want);
+
+    sock.close();
+    server.join();
+
+    std::cout << "[test_buffered_stream] test_socket_round_trip OK\n";
+  }
+} // namespace
+
+int main()
+{
+  test_ring_compact();
+  test_ring_mirrored();
+  test_small_reads_share_one_fill();
+  test_peek_consume_ensure();
+  test_write_buffer();
+  test_socket_round_trip();
+
+  std::cout << "[test_buffered_stream] all tests passed\n";
+  return 0;
+}
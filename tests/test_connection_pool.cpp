@@ -0,0 +1,382 @@
+#include <vix/net_corosio/connection_pool.hpp>
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/deadline.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/listener.hpp>
+#include <vix/net_corosio/socket.hpp>
+#include <vix/net_corosio/task.hpp>
+#include <vix/net_corosio/tls_context.hpp>
+#include <vix/net_corosio/tls_stream.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tls_fixtures.hpp"
+
+using namespace vix::net_corosio;
+
+namespace
+{
+  // Echoes each message; "quit" closes the connection, "shutdown" the server.
+  void echo_server(std::atomic<std::uint16_t> &port)
+  {
+    Context ctx;
+
+    Listener listener(ctx);
+    if (listener.open() || listener.bind(0) || listener.listen(16))
+      std::abort();
+
+    auto handler = [&](Socket client) -> Task<>
+    {
+      for (;;)
+      {
+        char buffer[64]{};
+        auto r = co_await client.async_read_some(buffer, sizeof(buffer));
+        if (!r.ok() || r.bytes == 0)
+          break;
+
+        const std::string msg(buffer, r.bytes);
+        if (msg == "quit")
+          break;
+
+        if (msg == "shutdown")
+        {
+          listener.close();
+          break;
+        }
+
+        if (!(co_await client.async_write_all(buffer, r.bytes)).ok())
+          break;
+      }
+
+      client.close();
+    };
+
+    auto accept_loop = [&]() -> Task<>
+    {
+      (void)co_await listener.serve(handler);
+    };
+
+    ctx.spawn(accept_loop());
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    (void)ctx.run();
+  }
+
+  void echo(PooledConnection &conn, const std::string &msg)
+  {
+    Socket &sock = conn.socket();
+
+    auto w = sock.write_all(msg.data(), msg.size());
+    assert(w.ok());
+    (void)w;
+
+    char buffer[64]{};
+    auto r = sock.read_exact(buffer, msg.size());
+    assert(r.ok());
+    assert(std::string(buffer, r.bytes) == msg);
+    (void)r;
+  }
+
+  void send_only(PooledConnection &conn, const std::string &msg)
+  {
+    auto w = conn.socket().write_all(msg.data(), msg.size());
+    assert(w.ok());
+    (void)w;
+  }
+
+  void test_reuse(const PoolTarget &target)
+  {
+    Context ctx;
+    ConnectionPool pool(ctx);
+
+    auto first = pool.checkout(target);
+    assert(first.ok());
+    assert(!first.connection.reused());
+    assert(first.connection.tls() == nullptr);
+    assert(pool.in_use_count() == 1);
+
+    const std::uint16_t local = first.connection.socket().local_endpoint().port;
+    echo(first.connection, "one");
+    first.connection.release();
+    assert(!first.connection);
+    assert(pool.idle_count() == 1);
+    assert(pool.in_use_count() == 0);
+
+    auto second = pool.checkout(target);
+    assert(second.ok());
+    assert(second.connection.reused());
+    assert(second.connection.socket().local_endpoint().port == local);
+    echo(second.connection, "two");
+
+    // Not released: closed, not pooled.
+    second.connection.discard();
+    assert(pool.idle_count() == 0);
+    assert(pool.in_use_count() == 0);
+
+    std::cout << "[test_connection_pool] test_reuse OK\n";
+  }
+
+  void test_health_check(const PoolTarget &target)
+  {
+    Context ctx;
+    ConnectionPool pool(ctx);
+
+    auto c = pool.checkout(target);
+    assert(c.ok());
+    const std::uint16_t local = c.connection.socket().local_endpoint().port;
+
+    send_only(c.connection, "quit");
+    c.connection.release();
+    assert(pool.idle_count() == 1);
+
+    // Let the server's FIN arrive.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    auto fresh = pool.checkout(target);
+    assert(fresh.ok());
+    assert(!fresh.connection.reused());
+    assert(fresh.connection.socket().local_endpoint().port != local);
+    echo(fresh.connection, "alive");
+    fresh.connection.release();
+
+    std::cout << "[test_connection_pool] test_health_check OK\n";
+  }
+
+  void test_max_per_host(const PoolTarget &target)
+  {
+    Context ctx;
+
+    PoolOptions opts{};
+    opts.max_per_host = 1;
+    ConnectionPool pool(ctx, opts);
+
+    auto held = pool.checkout(target);
+    assert(held.ok());
+
+    auto blocked = pool.checkout(target, Deadline::after(std::chrono::milliseconds(30)));
+    assert(blocked.error.code == ErrorCode::timeout);
+    assert(!blocked.connection);
+
+    held.connection.release();
+
+    auto next = pool.checkout(target, Deadline::after(std::chrono::seconds(2)));
+    assert(next.ok());
+    assert(next.connection.reused());
+    next.connection.release();
+
+    std::cout << "[test_connection_pool] test_max_per_host OK\n";
+  }
+
+  void test_waiter_woken_by_release(const PoolTarget &target)
+  {
+    Context ctx;
+
+    PoolOptions opts{};
+    opts.max_per_host = 1;
+    ConnectionPool pool(ctx, opts);
+
+    auto held = pool.checkout(target);
+    assert(held.ok());
+
+    // No deadline: only the release can end the wait.
+    CheckoutResult parked{};
+    std::chrono::steady_clock::duration waited{};
+    std::thread waiter([&]
+                       {
+      const auto start = std::chrono::steady_clock::now();
+      parked = pool.checkout(target, Deadline::never());
+      waited = std::chrono::steady_clock::now() - start; });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert(pool.in_use_count() == 1);
+    held.connection.release();
+
+    waiter.join();
+    assert(parked.ok());
+    assert(parked.connection.reused());
+    assert(waited < std::chrono::seconds(2));
+    parked.connection.release();
+
+    std::cout << "[test_connection_pool] test_waiter_woken_by_release OK\n";
+  }
+
+  void test_idle_eviction(const PoolTarget &target)
+  {
+    Context ctx;
+
+    PoolOptions opts{};
+    opts.idle_timeout = std::chrono::milliseconds(20);
+    ConnectionPool pool(ctx, opts);
+
+    auto c = pool.checkout(target);
+    assert(c.ok());
+    c.connection.release();
+    assert(pool.idle_count() == 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    assert(pool.evict_idle() == 1);
+    assert(pool.idle_count() == 0);
+
+    auto bad = pool.checkout(PoolTarget{});
+    assert(bad.error.code == ErrorCode::invalid_argument);
+
+    std::cout << "[test_connection_pool] test_idle_eviction OK\n";
+  }
+
+  void tls_echo(PooledConnection &conn, const std::string &msg)
+  {
+    TlsStream *tls = conn.tls();
+    assert(tls != nullptr);
+
+    auto w = tls->write_all(msg.data(), msg.size());
+    assert(w.ok());
+    (void)w;
+
+    char buffer[64]{};
+    auto r = tls->read_exact(buffer, msg.size());
+    assert(r.ok());
+    assert(std::string(buffer, r.bytes) == msg);
+    (void)r;
+  }
+
+  // Checks out, echoes and releases; returns whether the connection was reused.
+  bool tls_round(ConnectionPool &pool, const PoolTarget &target, const std::string &msg)
+  {
+    auto c = pool.checkout(target);
+    assert(c.ok());
+    assert(c.connection.tls() != nullptr);
+
+    const bool reused = c.connection.reused();
+    tls_echo(c.connection, msg);
+    c.connection.release();
+    return reused;
+  }
+
+  // SNI and ALPN are part of the key; a reused connection skips the handshake.
+  void test_tls_identity(const PoolTarget &tls_base, std::atomic<int> &handshakes)
+  {
+    Context ctx;
+    ConnectionPool pool(ctx);
+
+    // Unverified, so the SNI name can vary without failing the handshake.
+    TlsContext a(TlsRole::client);
+    (void)a.set_verify_mode(TlsVerifyMode::none);
+    (void)a.set_hostname("localhost");
+    (void)a.set_alpn(std::vector<std::string>{"http/1.1"});
+
+    PoolTarget target = tls_base;
+    target.tls = &a;
+
+    const int start = handshakes.load();
+
+    assert(!tls_round(pool, target, "first"));
+    assert(handshakes.load() == start + 1);
+
+    (void)a.set_hostname("other.localhost");
+    assert(!tls_round(pool, target, "sni"));
+
+    (void)a.set_hostname("localhost");
+    (void)a.set_alpn(std::vector<std::string>{"h2"});
+    assert(!tls_round(pool, target, "alpn"));
+    assert(pool.idle_count() == 3);
+    assert(handshakes.load() == start + 3);
+
+    // Back to the first identity: its idle connection, no new handshake.
+    (void)a.set_alpn(std::vector<std::string>{"http/1.1"});
+    assert(tls_round(pool, target, "again"));
+    assert(handshakes.load() == start + 3);
+
+    // Same settings on another TlsContext: still a separate connection.
+    TlsContext b(TlsRole::client);
+    (void)b.set_verify_mode(TlsVerifyMode::none);
+    (void)b.set_hostname("localhost");
+    (void)b.set_alpn(std::vector<std::string>{"http/1.1"});
+    target.tls = &b;
+    assert(!tls_round(pool, target, "other ctx"));
+    assert(handshakes.load() == start + 4);
+    assert(pool.idle_count() == 4);
+
+    pool.clear();
+
+    std::cout << "[test_connection_pool] test_tls_identity OK\n";
+  }
+
+  void stop_tls_server(const PoolTarget &tls_base)
+  {
+    Context ctx;
+    ConnectionPool pool(ctx);
+
+    TlsContext tls(TlsRole::client);
+    (void)tls.set_verify_mode(TlsVerifyMode::none);
+
+    PoolTarget target = tls_base;
+    target.tls = &tls;
+
+    auto c = pool.checkout(target);
+    assert(c.ok());
+
+    const std::string msg = "shutdown";
+    (void)c.connection.tls()->write_all(msg.data(), msg.size());
+  }
+
+  void stop_server(const PoolTarget &target)
+  {
+    Context ctx;
+    ConnectionPool pool(ctx);
+
+    auto c = pool.checkout(target);
+    assert(c.ok());
+    send_only(c.connection, "shutdown");
+  }
+} // namespace
+
+int main()
+{
+  std::atomic<std::uint16_t> port{0};
+  std::thread server([&]
+                     { echo_server(port); });
+
+  while (port.load(std::memory_order_acquire) == 0)
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  PoolTarget target{};
+  target.host = "127.0.0.1";
+  target.service = std::to_string(port.load(std::memory_order_acquire));
+
+  test_reuse(target);
+  test_health_check(target);
+  test_max_per_host(target);
+  test_waiter_woken_by_release(target);
+  test_idle_eviction(target);
+
+  stop_server(target);
+  server.join();
+
+  std::atomic<std::uint16_t> tls_port{0};
+  std::atomic<int> handshakes{0};
+  std::thread tls_server([&]
+                         { fixtures::tls_echo_server(tls_port, handshakes); });
+
+  while (tls_port.load(std::memory_order_acquire) == 0)
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  PoolTarget tls_target{};
+  tls_target.host = "127.0.0.1";
+  tls_target.service = std::to_string(tls_port.load(std::memory_order_acquire));
+
+  test_tls_identity(tls_target, handshakes);
+
+  stop_tls_server(tls_target);
+  tls_server.join();
+
+  std::cout << "[test_connection_pool] all tests passed\n";
+  return 0;
+}
@@ -1,6 +1,7 @@
 #include <vix/net_corosio/context.hpp>
 #include <vix/net_corosio/error.hpp>
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
 
@@ -73,6 +74,36 @@ namespace
 
     std::cout << "[test_context] test_run_returns_ok OK\n";
   }
+
+  void test_run_multi_threaded()
+  {
+    Config cfg = default_config();
+    cfg.io_threads = 4;
+
+    Context ctx(cfg);
+
+    constexpr int tasks = 64;
+    std::atomic<int> done{0};
+    std::atomic<bool> saw_running{true};
+
+    for (int i = 0; i < tasks; ++i)
+    {
+      ctx.spawn([](Context &c, std::atomic<int> &d, std::atomic<bool> &r) -> Task<>
+                {
+                  if (!c.running() || !c.running_in_this_thread())
+                    r.store(false);
+                  d.fetch_add(1);
+                  co_return; }(ctx, done, saw_running));
+    }
+
+    const Error e = ctx.run();
+    assert(!e);
+    assert(done.load() == tasks);
+    assert(saw_running.load());
+    assert(!ctx.running());
+
+    std::cout << "[test_context] test_run_multi_threaded OK\n";
+  }
 } // namespace
 
 int main()
@@ -82,6 +113,7 @@ int main()
   test_stop_requested_flag();
   test_native_handle();
   test_run_returns_ok();
+  test_run_multi_threaded();
 
   std::cout << "[test_context] all tests passed\n";
   return 0;
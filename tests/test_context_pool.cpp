@@ -0,0 +1,134 @@
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/context_pool.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/listener.hpp>
+#include <vix/net_corosio/socket.hpp>
+#include <vix/net_corosio/task.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace vix::net_corosio;
+
+namespace
+{
+  constexpr int kClients = 8;
+
+  void test_pool_shape()
+  {
+    ContextPool pool(3);
+
+    assert(pool.size() == 3);
+    assert(pool.at(0).config().io_threads == 1);
+    assert(pool.this_thread_context() == nullptr);
+
+    Context *first = &pool.next();
+    (void)pool.next();
+    (void)pool.next();
+    assert(&pool.next() == first);
+
+    ContextPool moved = std::move(pool);
+    assert(moved.size() == 3);
+
+    bool threw = false;
+    try
+    {
+      (void)pool.next();
+    }
+    catch (const std::out_of_range &)
+    {
+      threw = true;
+    }
+    assert(threw);
+
+    std::cout << "[test_context_pool] test_pool_shape OK\n";
+  }
+
+  void test_pool_reuseport_echo()
+  {
+    ContextPool pool(2);
+
+    std::atomic<int> served{0};
+    std::atomic<bool> on_pool_thread{true};
+
+    auto echo = [&](Socket client) -> Task<>
+    {
+      if (pool.this_thread_context() != client.context())
+        on_pool_thread.store(false);
+
+      std::vector<char> buffer(1024);
+      auto r = co_await client.async_read_some(buffer.data(), buffer.size());
+      if (r.ok() && r.bytes > 0)
+        (void)co_await client.async_write_all(buffer.data(), r.bytes);
+
+      client.close();
+      served.fetch_add(1);
+    };
+
+    assert(pool.port() == 0);
+
+    // Port 0: every shard ends up on the port picked for the first one.
+    const Error e_serve = pool.serve(0, echo);
+    if (e_serve.value() == ErrorCode::not_supported)
+    {
+      std::cout << "[test_context_pool] SKIP: SO_REUSEPORT not supported\n";
+      return;
+    }
+    assert(!e_serve);
+
+    const std::uint16_t port = pool.port();
+    assert(port != 0);
+
+    std::thread runner([&]
+                       { (void)pool.run(); });
+
+    for (int i = 0; i < kClients; ++i)
+    {
+      Context ctx;
+      Socket sock(ctx);
+
+      TcpEndpoint ep{};
+      ep.address = "127.0.0.1";
+      ep.port = port;
+
+      const Error e_conn = sock.connect(ep);
+      assert(!e_conn);
+
+      const std::string msg = "ping";
+      const auto w = sock.write_all(msg.data(), msg.size());
+      assert(w.ok());
+
+      char buf[16] = {};
+      auto r = sock.read_some(buf, sizeof(buf));
+      assert(r.ok() && std::string(buf, r.bytes) == msg);
+
+      sock.close();
+    }
+
+    while (served.load() < kClients)
+      std::this_thread::yield();
+
+    pool.stop();
+    runner.join();
+
+    assert(on_pool_thread.load());
+
+    std::cout << "[test_context_pool] test_pool_reuseport_echo OK\n";
+  }
+} // namespace
+
+int main()
+{
+  test_pool_shape();
+  test_pool_reuseport_echo();
+
+  std::cout << "[test_context_pool] all tests passed\n";
+  return 0;
+}
@@ -0,0 +1,225 @@
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/executor.hpp>
+#include <vix/net_corosio/strand.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace vix::net_corosio;
+
+namespace
+{
+  void test_copyable_handle()
+  {
+    Context ctx;
+
+    Executor a = ctx.get_executor();
+    Executor b = a;
+
+    assert(a.valid());
+    assert(b.valid());
+    assert(a == b);
+    assert(!a.running_in_this_thread());
+
+    Executor empty;
+    assert(!empty.valid());
+
+    std::cout << "[test_executor] test_copyable_handle OK\n";
+  }
+
+  void test_post_from_many_threads()
+  {
+    Context ctx;
+    Executor ex = ctx.get_executor();
+
+    constexpr int producers = 4;
+    constexpr int per_producer = 10000;
+
+    std::vector<std::vector<int>> seen(producers);
+    std::atomic<int> total{0};
+    std::atomic<bool> on_loop{true};
+
+    {
+      std::vector<std::jthread> threads;
+      for (int p = 0; p < producers; ++p)
+      {
+        threads.emplace_back([&, p]
+                             {
+                               for (int i = 0; i < per_producer; ++i)
+                               {
+                                 // Move-only payload: submissions must not require copies.
+                                 auto token = std::make_unique<int>(i);
+                                 ex.post([&, p, token = std::move(token)]
+                                         {
+                                           if (!ex.running_in_this_thread())
+                                             on_loop.store(false);
+                                           seen[p].push_back(*token);
+                                           total.fetch_add(1);
+                                         });
+                               } });
+      }
+    }
+
+    const Error e = ctx.run();
+    assert(!e);
+    assert(total.load() == producers * per_producer);
+    assert(on_loop.load());
+
+    // Per-producer submission order is preserved.
+    for (const auto &v : seen)
+    {
+      assert(static_cast<int>(v.size()) == per_producer);
+      for (int i = 0; i < per_producer; ++i)
+        assert(v[static_cast<std::size_t>(i)] == i);
+    }
+
+    std::cout << "[test_executor] test_post_from_many_threads OK\n";
+  }
+
+  void test_dispatch_and_defer()
+  {
+    Context ctx;
+    Executor ex = ctx.get_executor();
+
+    std::vector<int> order;
+
+    ex.post([&]
+            {
+              order.push_back(1);
+
+              ex.defer([&]
+                       { order.push_back(4); });
+
+              // On the loop thread dispatch runs inline.
+              ex.dispatch([&]
+                          { order.push_back(2); });
+
+              order.push_back(3); });
+
+    const Error e = ctx.run();
+    assert(!e);
+    assert((order == std::vector<int>{1, 2, 3, 4}));
+
+    std::cout << "[test_executor] test_dispatch_and_defer OK\n";
+  }
+
+  void test_strand_serializes_on_many_threads()
+  {
+    Config cfg = default_config();
+    cfg.io_threads = 4;
+
+    Context ctx(cfg);
+    Strand strand(ctx.get_executor());
+
+    constexpr int producers = 4;
+    constexpr int per_producer = 5000;
+
+    // Deliberately non-atomic: the strand is the only synchronization.
+    long counter = 0;
+    int inside = 0;
+    std::atomic<bool> overlapped{false};
+
+    {
+      std::vector<std::jthread> threads;
+      for (int p = 0; p < producers; ++p)
+      {
+        threads.emplace_back([&]
+                             {
+                               for (int i = 0; i < per_producer; ++i)
+                               {
+                                 strand.post([&]
+                                             {
+                                               if (++inside != 1)
+                                                 overlapped.store(true);
+                                               ++counter;
+                                               --inside; });
+                               } });
+      }
+    }
+
+    const Error e = ctx.run();
+    assert(!e);
+    assert(!overlapped.load());
+    assert(counter == static_cast<long>(producers) * per_producer);
+
+    std::cout << "[test_executor] test_strand_serializes_on_many_threads OK\n";
+  }
+
+  void test_strand_dispatch_inline_when_idle()
+  {
+    Context ctx;
+    Executor ex = ctx.get_executor();
+    Strand strand(ex);
+
+    std::vector<int> order;
+
+    ex.post([&]
+            {
+              order.push_back(1);
+
+              // Idle strand, caller on the loop: runs inline.
+              strand.dispatch([&]
+                              {
+                                assert(strand.running_in_this_thread());
+                                order.push_back(2);
+
+                                // Already inside the strand: post queues, dispatch nests.
+                                strand.post([&]
+                                            { order.push_back(5); });
+                                strand.dispatch([&]
+                                                { order.push_back(3); }); });
+
+              order.push_back(4);
+              assert(!strand.running_in_this_thread()); });
+
+    const Error e = ctx.run();
+    assert(!e);
+    assert((order == std::vector<int>{1, 2, 3, 4, 5}));
+
+    std::cout << "[test_executor] test_strand_dispatch_inline_when_idle OK\n";
+  }
+
+  void test_moved_from_strand()
+  {
+    Context ctx;
+    Strand strand(ctx.get_executor());
+    Strand other(std::move(strand));
+
+    // A moved-from strand drops work instead of crashing.
+    bool dropped = true;
+    strand.post([&]
+                { dropped = false; });
+    strand.dispatch([&]
+                    { dropped = false; });
+    assert(!strand.get_executor().valid());
+
+    bool ran = false;
+    other.post([&]
+               { ran = true; });
+
+    const Error e = ctx.run();
+    assert(!e);
+    assert(dropped && ran);
+
+    std::cout << "[test_executor] test_moved_from_strand OK\n";
+  }
+} // namespace
+
+int main()
+{
+  test_copyable_handle();
+  test_post_from_many_threads();
+  test_dispatch_and_defer();
+  test_strand_serializes_on_many_threads();
+  test_strand_dispatch_inline_when_idle();
+  test_moved_from_strand();
+
+  std::cout << "[test_executor] all tests passed\n";
+  return 0;
+}
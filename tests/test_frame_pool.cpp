@@ -0,0 +1,262 @@
+#include <vix/net_corosio/config.hpp>
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/listener.hpp>
+#include <vix/net_corosio/socket.hpp>
+#include <vix/net_corosio/task.hpp>
+
+#include <boost/corosio.hpp>
+#include <boost/capy/ex/run_async.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <thread>
+#include <utility>
+
+using namespace vix::net_corosio;
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+
+namespace
+{
+  // Heap allocations made by the current thread.
+  thread_local std::size_t tls_allocations = 0;
+
+  // Same check as detail::launcher: without allocator-aware launch the
+  // library falls back to the default allocator and frames are not pooled.
+  template <class Ex>
+  concept has_allocating_run_async =
+      requires(Ex ex, std::pmr::memory_resource *mr) { capy::run_async(ex, mr); };
+
+  constexpr bool kFramesPooled =
+      has_allocating_run_async<decltype(std::declval<corosio::io_context &>().get_executor())>;
+} // namespace
+
+void *operator new(std::size_t size)
+{
+  ++tls_allocations;
+
+  if (void *p = std::malloc(size == 0 ? 1 : size))
+    return p;
+
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+  constexpr int kWarmup = 100;
+  constexpr int kMeasured = 1000;
+  constexpr int kSpawned = 64;
+
+  void test_recycles_blocks()
+  {
+    Context ctx;
+    std::pmr::memory_resource *mr = ctx.frame_resource();
+    assert(mr != nullptr);
+
+    Context other;
+    assert(mr->is_equal(*other.frame_resource()));
+
+    void *a = mr->allocate(200);
+    mr->deallocate(a, 200);
+
+    // Same size class: the block comes straight back.
+    const std::size_t before = tls_allocations;
+    void *b = mr->allocate(180);
+    assert(b == a);
+    assert(tls_allocations == before);
+    (void)before;
+    mr->deallocate(b, 180);
+
+    // Oversized and over-aligned requests still work.
+    void *big = mr->allocate(1 << 16);
+    mr->deallocate(big, 1 << 16);
+
+    void *aligned = mr->allocate(128, 64);
+    assert(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+    mr->deallocate(aligned, 128, 64);
+
+    std::cout << "[test_frame_pool] test_recycles_blocks OK\n";
+  }
+
+  void echo_server(std::atomic<std::uint16_t> &port)
+  {
+    Context ctx;
+
+    Listener listener(ctx);
+    if (listener.open() || listener.bind(0) || listener.listen(1))
+      std::abort();
+
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    auto accepted = listener.accept();
+    if (!accepted.ok())
+      std::abort();
+
+    std::uint8_t b = 0;
+    for (;;)
+    {
+      auto r = accepted.socket.read_some(&b, 1);
+      if (!r.ok() || r.bytes == 0)
+        break;
+
+      auto w = accepted.socket.write_some(&b, 1);
+      if (!w.ok())
+        break;
+    }
+
+    accepted.socket.close();
+    listener.close();
+  }
+
+  // Pooled: steady-state I/O never reaches the global heap. Otherwise the
+  // wrapper frames of every operation come from it.
+  void test_steady_state_io_allocations()
+  {
+    std::atomic<std::uint16_t> port{0};
+    std::thread server([&]
+                       { echo_server(port); });
+
+    while (port.load(std::memory_order_acquire) == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    // Force every operation through the reactor and its coroutine frames.
+    Config cfg = default_config();
+    cfg.speculative_io = false;
+
+    Context ctx(cfg);
+    Socket sock(ctx);
+
+    TcpEndpoint ep{};
+    ep.address = "127.0.0.1";
+    ep.port = port.load(std::memory_order_acquire);
+
+    const Error e = sock.connect(ep);
+    assert(!e);
+    (void)e;
+
+    std::uint8_t b = 0x5A;
+
+    auto round_trip = [&]
+    {
+      auto w = sock.write_some(&b, 1);
+      assert(w.ok() && w.bytes == 1);
+      auto r = sock.read_some(&b, 1);
+      assert(r.ok() && r.bytes == 1);
+      (void)w;
+      (void)r;
+    };
+
+    for (int i = 0; i < kWarmup; ++i)
+      round_trip();
+
+    const std::size_t before = tls_allocations;
+
+    for (int i = 0; i < kMeasured; ++i)
+      round_trip();
+
+    const std::size_t allocations = tls_allocations - before;
+
+    sock.close();
+    server.join();
+
+    std::cout << "[test_frame_pool] allocations over " << kMeasured
+              << " round trips: " << allocations
+              << (kFramesPooled ? " (pooled)\n" : " (not pooled)\n");
+
+    if constexpr (kFramesPooled)
+      assert(allocations == 0);
+    else
+      assert(allocations >= kMeasured);
+
+    std::cout << "[test_frame_pool] test_steady_state_io_allocations OK\n";
+  }
+
+  Task<> bump(int &n)
+  {
+    ++n;
+    co_return;
+  }
+
+  // Heap allocations made while spawning kSpawned tasks with spawn_one.
+  // Each batch runs on a fresh Context; the frame caches are per thread.
+  template <class SpawnOne>
+  std::size_t spawn_allocations(SpawnOne spawn_one)
+  {
+    std::size_t allocations = 0;
+
+    // Warm the caches with the first batch, measure the second.
+    for (int batch = 0; batch < 2; ++batch)
+    {
+      Context ctx;
+      int ran = 0;
+
+      const std::size_t before = tls_allocations;
+      for (int i = 0; i < kSpawned; ++i)
+        spawn_one(ctx, ran);
+      allocations = tls_allocations - before;
+
+      (void)ctx.run();
+      assert(ran == kSpawned);
+    }
+
+    return allocations;
+  }
+
+  // spawn(make) creates the frame under the pool; spawn(Task<>) is handed
+  // one the caller already allocated.
+  void test_spawn_factory_frames()
+  {
+    const std::size_t factory = spawn_allocations([](Context &ctx, int &ran)
+                                                  { ctx.spawn([&ran]
+                                                              { return bump(ran); }); });
+
+    std::cout << "[test_frame_pool] allocations over " << kSpawned
+              << " factory spawns: " << factory << "\n";
+
+    if constexpr (kFramesPooled)
+      assert(factory == 0);
+    else
+      assert(factory >= kSpawned);
+
+    // Only the launch wrapper is pooled here, never the task frame.
+    const std::size_t eager = spawn_allocations([](Context &ctx, int &ran)
+                                                { ctx.spawn(bump(ran)); });
+
+    std::cout << "[test_frame_pool] allocations over " << kSpawned
+              << " task spawns: " << eager << "\n";
+    assert(eager >= factory);
+    (void)factory;
+    (void)eager;
+
+    std::cout << "[test_frame_pool] test_spawn_factory_frames OK\n";
+  }
+} // namespace
+
+int main()
+{
+  test_recycles_blocks();
+  test_steady_state_io_allocations();
+  test_spawn_factory_frames();
+
+  std::cout << "[test_frame_pool] all tests passed\n";
+  return 0;
+}
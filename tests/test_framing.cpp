@@ -0,0 +1,213 @@
+#include <vix/net_corosio/buffered_stream.hpp>
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/framing.hpp>
+#include <vix/net_corosio/listener.hpp>
+#include <vix/net_corosio/socket.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <span>
+#include <string>
+#include <thread>
+
+#include "stream_fixtures.hpp"
+
+using namespace vix::net_corosio;
+using fixtures::FakeStream;
+using fixtures::line_server;
+
+namespace
+{
+  void test_find_delimiter()
+  {
+    // Long enough to cover the vector loops and the scalar tail.
+    std::string hay(200, 'a');
+    assert(detail::find_delimiter(hay, "\n") == std::string_view::npos);
+    assert(detail::find_delimiter(hay, "aa") == 0);
+
+    for (std::size_t at : {0u, 1u, 15u, 16u, 31u, 32u, 33u, 100u, 197u, 198u})
+    {
+      std::string s = hay;
+      s.replace(at, 2, "\r\n");
+      assert(detail::find_delimiter(s, "\r\n") == at);
+      assert(detail::find_delimiter(s, "\n") == at + 1);
+    }
+
+    // First and last bytes match but the middle does not.
+    std::string tricky(64, '-');
+    tricky.replace(10, 4, "ABxD");
+    tricky.replace(40, 4, "ABCD");
+    assert(detail::find_delimiter(tricky, "ABCD") == 40);
+    assert(detail::find_delimiter("ab", "abc") == std::string_view::npos);
+
+    std::cout << "[test_framing] test_find_delimiter OK\n";
+  }
+
+  void test_lines_are_views()
+  {
+    FakeStream fake;
+    fake.input = "GET / HTTP/1.1\r\nHost: x\r\n\r\nbare\ntail";
+    BufferedStream<FakeStream> in(fake);
+
+    auto a = read_line(in);
+    auto b = read_line(in);
+    assert(a.ok() && a.data == "GET / HTTP/1.1");
+    assert(b.ok() && b.data == "Host: x");
+
+    // Earlier views stay valid until the next fill: one read served all.
+    assert(a.data == "GET / HTTP/1.1");
+    assert(a.data.data() >= in.read_buffer().view().data());
+
+    auto blank = read_line(in);
+    assert(blank.ok() && blank.data.empty());
+
+    auto bare = read_line(in);
+    assert(bare.ok() && bare.data == "bare");
+    assert(fake.reads == 1);
+
+    auto tail = read_line(in);
+    assert(tail.error.code == ErrorCode::connection_closed);
+
+    // The unterminated bytes are still there.
+    assert(in.peek() == "tail");
+
+    std::cout << "[test_framing] test_lines_are_views OK\n";
+  }
+
+  void test_delimiter_split_across_reads()
+  {
+    FakeStream fake;
+    fake.step = 3;
+    fake.input = "alpha\r\n\r\nbeta\r\n\r\n";
+    BufferedStream<FakeStream> in(fake);
+
+    auto a = read_until(in, "\r\n\r\n");
+    assert(a.ok() && a.data == "alpha\r\n\r\n");
+
+    auto b = read_until(in, "\r\n\r\n");
+    assert(b.ok() && b.data == "beta\r\n\r\n");
+
+    assert(read_until(in, "").error.code == ErrorCode::invalid_argument);
+
+    std::cout << "[test_framing] test_delimiter_split_across_reads OK\n";
+  }
+
+  void test_too_large()
+  {
+    FakeStream fake;
+    fake.input = std::string(64, 'x') + "\n";
+
+    BufferedStreamOptions opts{};
+    opts.read_buffer_bytes = 16;
+    BufferedStream<FakeStream> in(fake, opts);
+
+    assert(read_line(in).error.code == ErrorCode::message_too_large);
+
+    FakeStream framed;
+    framed.input = std::string("\x00\x20", 2) + std::string(32, 'y');
+    BufferedStream<FakeStream> frames(framed, opts);
+    assert(read_frame<LengthPrefix<std::uint16_t>>(frames).error.code == ErrorCode::message_too_large);
+
+    std::cout << "[test_framing] test_too_large OK\n";
+  }
+
+  void test_length_prefix()
+  {
+    using Be32 = LengthPrefix<std::uint32_t>;
+    using Le16 = LengthPrefix<std::uint16_t, std::endian::little>;
+
+    char header[4];
+    Be32::encode(0x01020304, header);
+    assert(std::memcmp(header, "\x01\x02\x03\x04", 4) == 0);
+    assert(Be32::decode(header) == 0x01020304);
+
+    Le16::encode(0x0102, header);
+    assert(std::memcmp(header, "\x02\x01", 2) == 0);
+    assert(Le16::decode(header) == 0x0102);
+
+    FakeStream fake;
+    BufferedStream<FakeStream> out(fake);
+    assert(write_frame<Be32>(out, "hello").ok());
+    assert(write_frame<Be32>(out, "").ok());
+    assert(write_frame<Be32>(out, "world!").ok());
+    assert(out.flush().ok());
+
+    FakeStream back;
+    back.input = fake.output;
+    back.step = 2;
+    BufferedStream<FakeStream> in(back);
+
+    // Two bytes per read: each frame needs fills, which may move the
+    // buffer, so check every view before the next call.
+    auto a = read_frame<Be32>(in);
+    assert(a.ok() && a.data == "hello");
+    auto b = read_frame<Be32>(in);
+    assert(b.ok() && b.data.empty());
+    auto c = read_frame<Be32>(in);
+    assert(c.ok() && c.data == "world!");
+    assert(read_frame<Be32>(in).error.code == ErrorCode::connection_closed);
+
+    const std::string big(300, 'z');
+    assert(write_frame<LengthPrefix<std::uint8_t>>(out, big).error.code == ErrorCode::message_too_large);
+
+    std::cout << "[test_framing] test_length_prefix OK\n";
+  }
+
+  constexpr int kLines = 500;
+
+  void test_socket_lines()
+  {
+    std::atomic<std::uint16_t> port{0};
+    std::thread server([&]
+                       { line_server(port, kLines, "\r\n"); });
+
+    while (port.load(std::memory_order_acquire) == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    Context ctx;
+    Socket sock(ctx);
+
+    const Error e = sock.connect(TcpEndpoint{"127.0.0.1", port.load(std::memory_order_acquire)});
+    assert(!e);
+    (void)e;
+
+    BufferedStreamOptions opts{};
+    opts.read_buffer_bytes = 256;
+    BufferedStream<Socket> in(sock, opts);
+
+    for (int i = 0; i < kLines; ++i)
+    {
+      auto line = read_line(in);
+      assert(line.ok());
+      assert(line.data == "line " + std::to_string(i));
+      (void)line;
+    }
+
+    assert(read_line(in).error.code == ErrorCode::connection_closed);
+
+    sock.close();
+    server.join();
+
+    std::cout << "[test_framing] test_socket_lines OK\n";
+  }
+} // namespace
+
+int main()
+{
+  test_find_delimiter();
+  test_lines_are_views();
+  test_delimiter_split_across_reads();
+  test_too_large();
+  test_length_prefix();
+  test_socket_lines();
+
+  std::cout << "[test_framing] all tests passed\n";
+  return 0;
+}
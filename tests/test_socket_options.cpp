@@ -0,0 +1,157 @@
+#include <vix/net_corosio/config.hpp>
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/listener.hpp>
+#include <vix/net_corosio/socket.hpp>
+#include <vix/net_corosio/socket_options.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace vix::net_corosio;
+
+namespace
+{
+  void test_merge()
+  {
+    SocketOptions base{};
+    assert(base.empty());
+
+    base.no_delay = true;
+    base.send_buffer_bytes = 1 << 20;
+
+    SocketOptions over{};
+    over.no_delay = false;
+    over.keep_alive = KeepAlive{true, std::chrono::seconds(30), std::chrono::seconds(5), 3};
+
+    base.merge(over);
+    assert(!base.empty());
+    assert(base.no_delay == false);
+    assert(base.send_buffer_bytes == (1 << 20));
+    assert(base.keep_alive && base.keep_alive->probes == 3);
+    assert(!base.quick_ack);
+
+    std::cout << "[test_socket_options] test_merge OK\n";
+  }
+
+  void test_socket_layers_config()
+  {
+    Config cfg = default_config();
+    cfg.socket_options.no_delay = true;
+
+    Context ctx(cfg);
+    Socket sock(ctx);
+    assert(sock.options().no_delay == true);
+
+    // Stored while closed, applied by open().
+    SocketOptions opts{};
+    opts.receive_buffer_bytes = 256 * 1024;
+    Error e = sock.set_options(opts);
+    assert(!e);
+
+    e = sock.open();
+    assert(!e);
+
+    const SocketOptions now = sock.options();
+    assert(now.no_delay == true);
+    assert(now.receive_buffer_bytes == 256 * 1024);
+
+    SocketOptions live{};
+    live.no_delay = false;
+    live.keep_alive = KeepAlive{};
+    e = sock.set_options(live);
+    assert(!e);
+    assert(sock.options().no_delay == false);
+    (void)e;
+
+    sock.close();
+
+    std::cout << "[test_socket_options] test_socket_layers_config OK\n";
+  }
+
+  void test_unknown_congestion_is_not_supported()
+  {
+#if defined(__linux__)
+    Context ctx;
+    Socket sock(ctx);
+    if (sock.open())
+      std::abort();
+
+    SocketOptions opts{};
+    opts.congestion = "vix-no-such-cc";
+    const Error e = sock.set_options(opts);
+    assert(e.value() == ErrorCode::not_supported);
+    (void)e;
+
+    sock.close();
+
+    std::cout << "[test_socket_options] test_unknown_congestion_is_not_supported OK\n";
+#endif
+  }
+
+  void client(std::uint16_t port)
+  {
+    Context ctx;
+    Socket sock(ctx);
+
+    TcpEndpoint ep{};
+    ep.address = "127.0.0.1";
+    ep.port = port;
+
+    if (sock.connect(ep))
+      std::abort();
+
+    char b = 0;
+    (void)sock.read_some(&b, 1);
+    sock.close();
+  }
+
+  void test_listener_options_are_inherited()
+  {
+    Config cfg = default_config();
+    cfg.socket_options.send_buffer_bytes = 128 * 1024;
+
+    Context ctx(cfg);
+    Listener listener(ctx);
+
+    SocketOptions opts{};
+    opts.no_delay = true;
+    opts.receive_buffer_bytes = 512 * 1024;
+    if (listener.set_options(opts) || listener.open() || listener.bind(0) || listener.listen(1))
+      std::abort();
+
+    std::thread peer(client, listener.local_endpoint().port);
+
+    auto accepted = listener.accept();
+    assert(accepted.ok());
+
+    const SocketOptions got = accepted.socket.options();
+    assert(got.no_delay == true);
+    assert(got.receive_buffer_bytes == 512 * 1024);
+    assert(got.send_buffer_bytes == 128 * 1024);
+
+    const char b = 1;
+    (void)accepted.socket.write_all(&b, 1);
+
+    peer.join();
+    accepted.socket.close();
+    listener.close();
+
+    std::cout << "[test_socket_options] test_listener_options_are_inherited OK\n";
+  }
+} // namespace
+
+int main()
+{
+  test_merge();
+  test_socket_layers_config();
+  test_unknown_congestion_is_not_supported();
+  test_listener_options_are_inherited();
+
+  std::cout << "[test_socket_options] all tests passed\n";
+  return 0;
+}
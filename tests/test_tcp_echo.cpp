@@ -1,23 +1,43 @@
+#include <vix/net_corosio/config.hpp>
 #include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/deadline.hpp>
 #include <vix/net_corosio/error.hpp>
 #include <vix/net_corosio/listener.hpp>
+#include <vix/net_corosio/resolver.hpp>
 #include <vix/net_corosio/socket.hpp>
+#include <vix/net_corosio/task.hpp>
 
 #include <cassert>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
 
+#if !defined(_WIN32)
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 using namespace vix::net_corosio;
 
 namespace
 {
-  constexpr std::uint16_t kTestPort = 19080;
+  constexpr std::size_t kPartialPayload = 16 * 1024 * 1024;
+  constexpr std::size_t kZeroCopyPayload = 4 * 1024 * 1024;
+  constexpr std::size_t kSendFileSize = 8 * 1024 * 1024 + 123;
+  constexpr int kFastOpenConnections = 2;
+  constexpr int kHappyEyeballsConnections = 3;
+  constexpr int kServeClients = 4;
+  constexpr std::size_t kServeLimit = 2;
 
   static void sleep_short()
   {
@@ -99,17 +119,17 @@ namespace
     std::thread t_;
   };
 
-  void run_server_once(std::atomic<bool> &ready)
+  void run_server_once(std::atomic<std::uint16_t> &port)
   {
     Context ctx;
     ContextPump pump(ctx);
 
     Listener listener(ctx);
     require_ok("listener.open", listener.open());
-    require_ok("listener.bind", listener.bind(kTestPort));
+    require_ok("listener.bind", listener.bind(0));
     require_ok("listener.listen", listener.listen(1));
 
-    ready.store(true, std::memory_order_release);
+    port.store(listener.local_endpoint().port, std::memory_order_release);
 
     auto accepted = listener.accept();
     if (!accepted.ok())
@@ -123,8 +143,8 @@ namespace
     require_ok("server.read_some", r);
     assert(r.bytes > 0);
 
-    auto w = client.write_some(buffer.data(), r.bytes);
-    require_ok("server.write_some", w);
+    auto w = client.write_all(buffer.data(), r.bytes);
+    require_ok("server.write_all", w);
 
     client.close();
     listener.close();
@@ -132,7 +152,7 @@ namespace
     pump.stop();
   }
 
-  void run_client_once()
+  void run_client_once(std::uint16_t port)
   {
     Context ctx;
     ContextPump pump(ctx);
@@ -141,14 +161,14 @@ namespace
 
     TcpEndpoint ep{};
     ep.address = "127.0.0.1";
-    ep.port = kTestPort;
+    ep.port = port;
 
     require_ok("client.connect", sock.connect(ep));
 
     const std::string msg = "hello from client\n";
 
-    auto w = sock.write_some(msg.data(), msg.size());
-    require_ok("client.write_some", w);
+    auto w = sock.write_all(msg.data(), msg.size());
+    require_ok("client.write_all", w);
 
     std::vector<char> buffer(4096);
 
@@ -163,25 +183,966 @@ namespace
 
     pump.stop();
   }
-} // namespace
 
-int main()
-{
-  std::atomic<bool> ready{false};
+  void run_async_client_once(std::uint16_t port)
+  {
+    Context ctx;
+
+    Socket sock(ctx);
+
+    const std::string msg = "hello from async client\n";
+    std::vector<char> buffer(4096);
+    bool echoed_ok = false;
+
+    auto session = [&]() -> Task<>
+    {
+      TcpEndpoint ep{};
+      ep.address = "127.0.0.1";
+      ep.port = port;
+
+      require_ok("async_client.connect", co_await sock.async_connect(ep));
+
+      auto w = co_await sock.async_write_all(msg.data(), msg.size());
+      require_ok("async_client.write_all", w);
+
+      auto r = co_await sock.async_read_some(buffer.data(), buffer.size());
+      require_ok("async_client.read_some", r);
 
-  std::thread server_thread([&]
-                            { run_server_once(ready); });
+      echoed_ok = std::string(buffer.data(), r.bytes) == msg;
+      sock.close();
+    };
 
-  for (int i = 0; i < 400; ++i)
+    ctx.spawn(session());
+    require_ok("async_client.run", ctx.run());
+
+    assert(echoed_ok);
+  }
+
+  void run_serve_server(std::atomic<std::uint16_t> &port)
   {
-    if (ready.load(std::memory_order_acquire))
-      break;
-    sleep_short();
+    Context ctx;
+
+    Listener listener(ctx);
+    require_ok("listener.open", listener.open());
+    require_ok("listener.bind", listener.bind(0));
+    require_ok("listener.listen", listener.listen(8));
+
+    int served = 0;
+    std::size_t live = 0;
+    std::size_t peak = 0;
+
+    auto echo = [&](Socket client) -> Task<>
+    {
+      peak = std::max(peak, ++live);
+
+      std::vector<char> buffer(4096);
+      auto r = co_await client.async_read_some(buffer.data(), buffer.size());
+      if (r.ok() && r.bytes > 0)
+        (void)co_await client.async_write_all(buffer.data(), r.bytes);
+
+      client.close();
+      --live;
+
+      if (++served == kServeClients)
+        listener.close();
+    };
+
+    auto accept_loop = [&]() -> Task<>
+    {
+      require_ok("listener.serve", co_await listener.serve(echo, kServeLimit));
+    };
+
+    ctx.spawn(accept_loop());
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    require_ok("serve.run", ctx.run());
+
+    assert(served == kServeClients);
+    assert(peak <= kServeLimit);
+  }
+
+  void run_serve_clients(std::uint16_t port)
+  {
+    for (int i = 0; i < kServeClients; ++i)
+      run_client_once(port);
   }
 
-  run_client_once();
+  // Accepts one connection and never writes: reads until the peer leaves.
+  void run_silent_server(std::atomic<std::uint16_t> &port)
+  {
+    Context ctx;
+    ContextPump pump(ctx);
+
+    Listener listener(ctx);
+    require_ok("listener.open", listener.open());
+    require_ok("listener.bind", listener.bind(0));
+    require_ok("listener.listen", listener.listen(1));
+
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    auto accepted = listener.accept();
+    if (!accepted.ok())
+      fail("listener.accept", accepted.error);
+
+    std::vector<char> buffer(256);
+    for (;;)
+    {
+      auto r = accepted.socket.read_some(buffer.data(), buffer.size());
+      if (!r.ok() || r.bytes == 0)
+        break;
+    }
+
+    accepted.socket.close();
+    listener.close();
+
+    pump.stop();
+  }
+
+  void run_deadline_client(std::uint16_t port)
+  {
+    Config cfg = default_config();
+    cfg.io_timeout = std::chrono::milliseconds(30);
+
+    Context ctx(cfg);
+    Socket sock(ctx);
+    assert(sock.timeout() == std::chrono::milliseconds(30));
+
+    TcpEndpoint ep{};
+    ep.address = "127.0.0.1";
+    ep.port = port;
+
+    require_ok("deadline_client.connect", sock.connect(ep));
+
+    std::vector<char> buffer(256);
+
+    // Config default.
+    auto start = std::chrono::steady_clock::now();
+    auto r = sock.read_some(buffer.data(), buffer.size());
+    assert(r.error.code == ErrorCode::timeout);
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(30));
+
+    // Explicit per-operation deadline overrides the default.
+    start = std::chrono::steady_clock::now();
+    r = sock.read_some(buffer.data(), buffer.size(), Deadline::after(std::chrono::milliseconds(60)));
+    assert(r.error.code == ErrorCode::timeout);
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(60));
+
+    // A deadline already in the past fails without touching the socket.
+    r = sock.read_some(buffer.data(), buffer.size(), Deadline::at(std::chrono::steady_clock::now()));
+    assert(r.error.code == ErrorCode::timeout);
+
+    sock.close();
+  }
+
+  // Polls try_read_some() until data arrives; only would_block may precede it.
+  static IoResult try_read_until_data(Socket &s, void *buf, std::size_t n)
+  {
+    for (int i = 0; i < 800; ++i)
+    {
+      auto r = s.try_read_some(buf, n);
+      if (r.error.code != ErrorCode::would_block)
+        return r;
+
+      sleep_short();
+    }
+    return s.try_read_some(buf, n);
+  }
+
+  void run_try_server(std::atomic<std::uint16_t> &port)
+  {
+    Context ctx;
+
+    Listener listener(ctx);
+    require_ok("listener.open", listener.open());
+    require_ok("listener.bind", listener.bind(0));
+    require_ok("listener.listen", listener.listen(1));
+
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    auto accepted = listener.accept();
+    if (!accepted.ok())
+      fail("listener.accept", accepted.error);
+
+    Socket &client = accepted.socket;
+    std::vector<char> buffer(256);
+
+    auto r = try_read_until_data(client, buffer.data(), buffer.size());
+    require_ok("try_server.try_read_some", r);
+
+    auto w = client.try_write_some(buffer.data(), r.bytes);
+    require_ok("try_server.try_write_some", w);
+    assert(w.bytes == r.bytes);
+
+    // The peer closes after reading the echo.
+    r = try_read_until_data(client, buffer.data(), buffer.size());
+    assert(r.error.code == ErrorCode::connection_closed);
+
+    client.close();
+    listener.close();
+  }
+
+  void run_try_client(std::uint16_t port)
+  {
+    Context ctx;
+    Socket sock(ctx);
+
+    std::vector<char> buffer(256);
+
+    // Not connected yet.
+    auto r = sock.try_read_some(buffer.data(), buffer.size());
+    assert(r.error.code == ErrorCode::invalid_state);
+
+    TcpEndpoint ep{};
+    ep.address = "127.0.0.1";
+    ep.port = port;
+
+    require_ok("try_client.connect", sock.connect(ep));
+
+    // The server only writes after it hears from us.
+    r = sock.try_read_some(buffer.data(), buffer.size());
+    assert(r.error.code == ErrorCode::would_block);
+
+    const std::string msg = "try ping";
+    auto w = sock.try_write_some(msg.data(), msg.size());
+    require_ok("try_client.try_write_some", w);
+    assert(w.bytes == msg.size());
+
+    r = try_read_until_data(sock, buffer.data(), buffer.size());
+    require_ok("try_client.try_read_some", r);
+    assert(std::string(buffer.data(), r.bytes) == msg);
+
+    sock.close();
+  }
+
+  // Fill header then body with scatter reads until both are full.
+  IoResult read_vectored(Socket &s, char *head, std::size_t head_size,
+                         char *body, std::size_t body_size)
+  {
+    std::size_t got = 0;
+    const std::size_t total = head_size + body_size;
+
+    while (got < total)
+    {
+      const std::size_t in_head = got < head_size ? got : head_size;
+      const std::size_t in_body = got - in_head;
+
+      const MutableBuffer bufs[] = {
+          MutableBuffer{head + in_head, head_size - in_head},
+          MutableBuffer{body + in_body, body_size - in_body},
+      };
+
+      auto r = s.read_some(bufs);
+      if (!r.ok() || r.bytes == 0)
+        return r;
+
+      got += r.bytes;
+    }
+
+    return IoResult{Error{ErrorCode::none}, got};
+  }
+
+  void run_vectored_server(std::atomic<std::uint16_t> &port)
+  {
+    Context ctx;
+
+    Listener listener(ctx);
+    require_ok("listener.open", listener.open());
+    require_ok("listener.bind", listener.bind(0));
+    require_ok("listener.listen", listener.listen(1));
+
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    auto accepted = listener.accept();
+    if (!accepted.ok())
+      fail("listener.accept", accepted.error);
+
+    Socket &client = accepted.socket;
+
+    char head[4]{};
+    std::vector<char> body(64 * 1024);
+
+    auto r = read_vectored(client, head, sizeof(head), body.data(), body.size());
+    require_ok("vectored_server.read_some", r);
+
+    // Echo with the two parts swapped.
+    const ConstBuffer out[] = {
+        ConstBuffer{body.data(), body.size()},
+        ConstBuffer{head, sizeof(head)},
+    };
+
+    auto w = client.write_all(out);
+    require_ok("vectored_server.write_all", w);
+
+    client.close();
+    listener.close();
+  }
+
+  void run_vectored_client(std::uint16_t port)
+  {
+    Context ctx;
+    Socket sock(ctx);
+
+    TcpEndpoint ep{};
+    ep.address = "127.0.0.1";
+    ep.port = port;
+
+    require_ok("vectored_client.connect", sock.connect(ep));
+
+    const char head[4] = {'H', 'E', 'A', 'D'};
+    std::vector<char> body(64 * 1024);
+    for (std::size_t i = 0; i < body.size(); ++i)
+      body[i] = static_cast<char>('a' + i % 26);
+
+    // Empty buffers are skipped; an all-empty sequence is rejected.
+    const ConstBuffer empty[] = {ConstBuffer{}, ConstBuffer{head, 0}};
+    auto e = sock.write_some(empty);
+    assert(e.error.code == ErrorCode::invalid_argument);
+
+    const ConstBuffer out[] = {
+        ConstBuffer{head, sizeof(head)},
+        ConstBuffer{},
+        ConstBuffer{body.data(), body.size()},
+    };
+
+    auto w = sock.write_all(out);
+    require_ok("vectored_client.write_all", w);
+    assert(w.bytes == sizeof(head) + body.size());
+
+    std::vector<char> echo_body(body.size());
+    char echo_head[4]{};
+
+    auto r = read_vectored(sock, echo_body.data(), echo_body.size(), echo_head, sizeof(echo_head));
+    require_ok("vectored_client.read_some", r);
+    assert(r.bytes == w.bytes);
+    assert(echo_body == body);
+    assert(std::string(echo_head, sizeof(echo_head)) == "HEAD");
+
+    sock.close();
+  }
+
+  void run_partial_server(std::atomic<std::uint16_t> &port)
+  {
+    Context ctx;
+
+    Listener listener(ctx);
+    require_ok("listener.open", listener.open());
+    require_ok("listener.bind", listener.bind(0));
+    require_ok("listener.listen", listener.listen(1));
+
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    auto accepted = listener.accept();
+    if (!accepted.ok())
+      fail("listener.accept", accepted.error);
+
+    Socket &client = accepted.socket;
+
+    // Let the client fill the socket buffers before draining them.
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    std::vector<char> buffer(kPartialPayload);
+    auto r = client.read_exact(buffer.data(), buffer.size());
+    require_ok("partial_server.read_exact", r);
+    assert(r.bytes == buffer.size());
+    assert(buffer.front() == 'p' && buffer.back() == 'p');
+
+    char extra = 0;
+    r = client.read_exact(&extra, 1);
+    assert(r.error.code == ErrorCode::connection_closed);
+    assert(r.bytes == 0);
+
+    client.close();
+    listener.close();
+  }
+
+  void run_partial_client(std::uint16_t port)
+  {
+    Context ctx;
+    Socket sock(ctx);
+
+    TcpEndpoint ep{};
+    ep.address = "127.0.0.1";
+    ep.port = port;
+
+    require_ok("partial_client.connect", sock.connect(ep));
+
+    const std::vector<char> payload(kPartialPayload, 'p');
+
+    // More than the kernel buffers hold: one call, partial progress.
+    auto w = sock.write_some(payload.data(), payload.size());
+    require_ok("partial_client.write_some", w);
+    assert(w.bytes > 0 && w.bytes < payload.size());
+
+    auto rest = sock.write_all(payload.data() + w.bytes, payload.size() - w.bytes);
+    require_ok("partial_client.write_all", rest);
+    assert(w.bytes + rest.bytes == payload.size());
+
+    sock.close();
+  }
+
+  void run_zero_copy_server(std::atomic<std::uint16_t> &port)
+  {
+    Context ctx;
+
+    Listener listener(ctx);
+    require_ok("listener.open", listener.open());
+    require_ok("listener.bind", listener.bind(0));
+    require_ok("listener.listen", listener.listen(1));
+
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    auto accepted = listener.accept();
+    if (!accepted.ok())
+      fail("listener.accept", accepted.error);
+
+    Socket &client = accepted.socket;
+
+    std::vector<char> buffer(kZeroCopyPayload);
+    auto r = client.read_exact(buffer.data(), buffer.size());
+    require_ok("zero_copy_server.read_exact", r);
+    assert(std::all_of(buffer.begin(), buffer.end(), [](char c)
+                       { return c == 'z'; }));
+
+    client.close();
+    listener.close();
+  }
+
+  void run_zero_copy_client(std::uint16_t port)
+  {
+    Context ctx;
+    Socket sock(ctx);
+
+    // Not open yet.
+    assert(sock.set_zero_copy(true).code == ErrorCode::invalid_state);
+
+    require_ok("zero_copy_client.open", sock.open());
+
+    const Error e = sock.set_zero_copy(true);
+    if (e.code == ErrorCode::not_supported)
+      std::cout << "[test_tcp_echo] zero copy not supported, using copies\n";
+    else
+      require_ok("zero_copy_client.set_zero_copy", e);
+
+    TcpEndpoint ep{};
+    ep.address = "127.0.0.1";
+    ep.port = port;
+
+    require_ok("zero_copy_client.connect", sock.connect(ep));
+
+    // write_all() returns only after the kernel released the pages.
+    std::vector<char> payload(kZeroCopyPayload, 'z');
+    auto w = sock.write_all(payload.data(), payload.size());
+    require_ok("zero_copy_client.write_all", w);
+    assert(w.bytes == payload.size());
+
+    sock.close();
+  }
+
+  void run_zero_copy_reopen_server(std::atomic<std::uint16_t> &port)
+  {
+    Context ctx;
+
+    Listener listener(ctx);
+    require_ok("listener.open", listener.open());
+    require_ok("listener.bind", listener.bind(0));
+    require_ok("listener.listen", listener.listen(2));
+
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    std::vector<char> buffer(kZeroCopyPayload);
+    for (int round = 0; round < 2; ++round)
+    {
+      auto accepted = listener.accept();
+      if (!accepted.ok())
+        fail("listener.accept", accepted.error);
+
+      auto r = accepted.socket.read_exact(buffer.data(), buffer.size());
+      require_ok("zero_copy_reopen_server.read_exact", r);
+      assert(std::all_of(buffer.begin(), buffer.end(), [](char c)
+                         { return c == 'r'; }));
+
+      accepted.socket.close();
+    }
+
+    listener.close();
+  }
+
+  // Every fd the socket opens gets SO_ZEROCOPY again and starts with
+  // fresh completion counters; a stale state would hang in write_all().
+  void run_zero_copy_reopen_client(std::uint16_t port)
+  {
+    Context ctx;
+    Socket sock(ctx);
+
+    require_ok("zero_copy_reopen_client.open", sock.open());
+    const Error e = sock.set_zero_copy(true);
+    if (e.code == ErrorCode::not_supported)
+      std::cout << "[test_tcp_echo] zero copy not supported, using copies\n";
+    else
+      require_ok("zero_copy_reopen_client.set_zero_copy", e);
+
+    // Closed before use: connect() opens a new fd.
+    sock.close();
+    assert(sock.zero_copy() == !e);
+
+    std::vector<char> payload(kZeroCopyPayload, 'r');
+    for (int round = 0; round < 2; ++round)
+    {
+      require_ok("zero_copy_reopen_client.connect", sock.connect(TcpEndpoint{"127.0.0.1", port}));
+
+      auto w = sock.write_all(payload.data(), payload.size(), Deadline::after(std::chrono::seconds(10)));
+      require_ok("zero_copy_reopen_client.write_all", w);
+      assert(w.bytes == payload.size());
+
+      sock.close();
+    }
+  }
+
+  std::string send_file_path()
+  {
+    return (std::filesystem::temp_directory_path() / "net_corosio_send_file.bin").string();
+  }
+
+  char send_file_byte(std::size_t i)
+  {
+    return static_cast<char>('A' + (i * 7) % 26);
+  }
+
+  void run_send_file_server(std::atomic<std::uint16_t> &port)
+  {
+    const std::string path = send_file_path();
+    {
+      std::ofstream f(path, std::ios::binary | std::ios::trunc);
+      for (std::size_t i = 0; i < kSendFileSize; ++i)
+        f.put(send_file_byte(i));
+    }
+
+    Context ctx;
+
+    Listener listener(ctx);
+    require_ok("listener.open", listener.open());
+    require_ok("listener.bind", listener.bind(0));
+    require_ok("listener.listen", listener.listen(1));
+
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    auto accepted = listener.accept();
+    if (!accepted.ok())
+      fail("listener.accept", accepted.error);
+
+    Socket &client = accepted.socket;
+
+    // Whole file; the slow reader forces the backpressure path.
+    auto r = client.send_file(path);
+    require_ok("send_file_server.send_file", r);
+    assert(r.bytes == kSendFileSize);
+
+    // A range, then a range past the end of the file.
+    auto part = client.send_file(path, 1000, 5000);
+    require_ok("send_file_server.send_file range", part);
+    assert(part.bytes == 5000);
+
+    auto past = client.send_file(path, kSendFileSize + 1);
+    assert(past.error.code == ErrorCode::invalid_argument);
+
+    auto missing = client.send_file(path + ".missing");
+    assert(missing.error.code == ErrorCode::invalid_argument);
+
+    client.close();
+    listener.close();
+
+    std::filesystem::remove(path);
+  }
+
+  void run_send_file_client(std::uint16_t port)
+  {
+    Context ctx;
+    Socket sock(ctx);
+
+    TcpEndpoint ep{};
+    ep.address = "127.0.0.1";
+    ep.port = port;
+
+    require_ok("send_file_client.connect", sock.connect(ep));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::vector<char> buffer(kSendFileSize);
+    auto r = sock.read_exact(buffer.data(), buffer.size());
+    require_ok("send_file_client.read_exact", r);
+
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+      assert(buffer[i] == send_file_byte(i));
+
+    r = sock.read_exact(buffer.data(), 5000);
+    require_ok("send_file_client.read_exact range", r);
+
+    for (std::size_t i = 0; i < 5000; ++i)
+      assert(buffer[i] == send_file_byte(1000 + i));
+
+    sock.close();
+  }
+
+  void run_fast_open_server(std::atomic<std::uint16_t> &port)
+  {
+    Context ctx;
+
+    Listener listener(ctx);
+    require_ok("listener.open", listener.open());
+
+    // Only after open() and before listen().
+    assert(listener.set_fast_open(0).code == ErrorCode::invalid_argument);
+
+    const Error tfo = listener.set_fast_open(16);
+    if (tfo.code != ErrorCode::not_supported)
+      require_ok("listener.set_fast_open", tfo);
+
+    require_ok("listener.bind", listener.bind(0));
+    require_ok("listener.listen", listener.listen(4));
+
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    // The first connection fetches a cookie; the second may carry data in its SYN.
+    for (int i = 0; i < kFastOpenConnections; ++i)
+    {
+      auto accepted = listener.accept();
+      if (!accepted.ok())
+        fail("listener.accept", accepted.error);
+
+      Socket &client = accepted.socket;
+
+      char buffer[64]{};
+      auto r = client.read_some(buffer, sizeof(buffer));
+      require_ok("fast_open_server.read_some", r);
+
+      auto w = client.write_all(buffer, r.bytes);
+      require_ok("fast_open_server.write_all", w);
+
+      client.close();
+    }
+
+    listener.close();
+  }
+
+  void run_fast_open_client(std::uint16_t port)
+  {
+    TcpEndpoint ep{};
+    ep.address = "127.0.0.1";
+    ep.port = port;
+
+    const std::string msg = "fast open hello";
+
+    for (int i = 0; i < kFastOpenConnections; ++i)
+    {
+      Context ctx;
+      Socket sock(ctx);
+
+      auto w = sock.connect_with_data(ep, msg.data(), msg.size());
+      require_ok("fast_open_client.connect_with_data", w);
+      assert(w.bytes == msg.size());
+      assert(sock.state() == SocketState::connected);
+
+      char buffer[64]{};
+      auto r = sock.read_exact(buffer, msg.size());
+      require_ok("fast_open_client.read_exact", r);
+      assert(std::string(buffer, r.bytes) == msg);
+
+      sock.close();
+    }
+  }
+
+  // Echoes one message on each of kHappyEyeballsConnections connections.
+  void run_happy_eyeballs_server(std::atomic<std::uint16_t> &port)
+  {
+    Context ctx;
+
+    Listener listener(ctx);
+    require_ok("listener.open", listener.open());
+    require_ok("listener.bind", listener.bind(0));
+    require_ok("listener.listen", listener.listen(4));
+
+    port.store(listener.local_endpoint().port, std::memory_order_release);
+
+    for (int i = 0; i < kHappyEyeballsConnections; ++i)
+    {
+      auto accepted = listener.accept();
+      if (!accepted.ok())
+        fail("listener.accept", accepted.error);
+
+      Socket &client = accepted.socket;
+
+      char buffer[64]{};
+      auto r = client.read_some(buffer, sizeof(buffer));
+      require_ok("happy_eyeballs_server.read_some", r);
+
+      auto w = client.write_all(buffer, r.bytes);
+      require_ok("happy_eyeballs_server.write_all", w);
+
+      client.close();
+    }
+
+    listener.close();
+  }
+
+  void echo_once(Socket &sock, const char *what)
+  {
+    const std::string msg = what;
+    require_ok("happy_eyeballs_client.write_all", sock.write_all(msg.data(), msg.size()));
+
+    char buffer[64]{};
+    auto r = sock.read_exact(buffer, msg.size());
+    require_ok("happy_eyeballs_client.read_exact", r);
+    assert(std::string(buffer, r.bytes) == msg);
+  }
+
+  // A listener whose accept queue is full drops new SYNs (Linux), so a
+  // connect there stalls like one to a blackholed address.
+  bool fill_accept_queue(Context &ctx, std::uint16_t port, std::vector<Socket> &fillers)
+  {
+    fillers.reserve(64);
+    for (int i = 0; i < 64; ++i)
+    {
+      Socket &s = fillers.emplace_back(ctx);
+      const Error e = s.connect(TcpEndpoint{"127.0.0.1", port}, Deadline::after(std::chrono::milliseconds(200)));
+      if (e.code == ErrorCode::timeout)
+        return true;
+      if (e)
+        return false;
+    }
+    return false;
+  }
+
+  // Stalled first address: the second attempt starts after the pacing
+  // delay, wins, and the stalled attempt is cancelled rather than left to
+  // run until the socket timeout.
+  void run_happy_eyeballs_stalled(Context &ctx, std::uint16_t port)
+  {
+    Listener stalled(ctx);
+    require_ok("stalled.open", stalled.open());
+    require_ok("stalled.bind", stalled.bind(0));
+    require_ok("stalled.listen", stalled.listen(1));
+    const std::uint16_t stalled_port = stalled.local_endpoint().port;
+
+    std::vector<Socket> fillers;
+    if (!fill_accept_queue(ctx, stalled_port, fillers))
+    {
+      std::cout << "[test_tcp_echo] SYNs to a full accept queue are not dropped, skipping stalled happy eyeballs\n";
+
+      Socket sock(ctx);
+      require_ok("happy_eyeballs_client.connect", sock.connect(TcpEndpoint{"127.0.0.1", port}));
+      echo_once(sock, "not stalled");
+      sock.close();
+    }
+    else
+    {
+      const auto delay = ctx.config().connect_attempt_delay;
+
+      ResolveResult resolved{};
+      resolved.endpoints.push_back(Endpoint{IpVersion::v4, "127.0.0.1", stalled_port});
+      resolved.endpoints.push_back(Endpoint{IpVersion::v4, "127.0.0.1", port});
+
+      Socket sock(ctx);
+      sock.set_timeout(std::chrono::seconds(5));
+
+      const auto started = std::chrono::steady_clock::now();
+      require_ok("happy_eyeballs_client.connect_any(stalled)", sock.connect_any(resolved));
+      const auto elapsed = std::chrono::steady_clock::now() - started;
+
+      // connect_any() returns only once every attempt has finished, so a
+      // loser left running would hold it for the 5 s timeout.
+      assert(elapsed >= delay);
+      assert(elapsed < std::chrono::seconds(2));
+      assert(sock.remote_endpoint().port == port);
+      (void)elapsed;
+
+      echo_once(sock, "stalled first");
+      sock.close();
+    }
+
+    for (auto &f : fillers)
+      f.close();
+    stalled.close();
+  }
+
+  void run_happy_eyeballs_client(std::uint16_t port)
+  {
+    Config cfg = default_config();
+    cfg.connect_attempt_delay = std::chrono::milliseconds(50);
+
+    Context ctx(cfg);
+
+    // Bound but not listening: connecting there is refused.
+    Listener dead(ctx);
+    require_ok("dead.bind", dead.bind(0));
+    const std::uint16_t dead_port = dead.local_endpoint().port;
+
+    Socket empty(ctx);
+    assert(empty.connect_any(ResolveResult{}).code == ErrorCode::invalid_argument);
+
+    ResolveResult refused{};
+    refused.endpoints.push_back(Endpoint{IpVersion::v4, "127.0.0.1", dead_port});
+
+    Socket lost(ctx);
+    assert(lost.connect_any(refused).code == ErrorCode::connect_failed);
+    assert(lost.state() != SocketState::connected);
+
+    // A refused address first: the next one starts without waiting out the delay.
+    ResolveResult resolved = refused;
+    resolved.endpoints.push_back(Endpoint{IpVersion::v4, "127.0.0.1", port});
+
+    SocketOptions opts{};
+    opts.no_delay = true;
+
+    Socket sock(ctx);
+    require_ok("sock.set_options", sock.set_options(opts));
+    sock.set_timeout(std::chrono::seconds(5));
+
+    require_ok("happy_eyeballs_client.connect_any", sock.connect_any(resolved));
+    assert(sock.state() == SocketState::connected);
+    assert(sock.remote_endpoint().port == port);
+    assert(sock.options().no_delay == true);
+    assert(sock.timeout() == std::chrono::seconds(5));
+    echo_once(sock, "happy eyeballs");
+    sock.close();
+
+    Socket by_name(ctx);
+    require_ok("happy_eyeballs_client.connect", by_name.connect("localhost", std::to_string(port)));
+    echo_once(by_name, "by name");
+    by_name.close();
+
+    dead.close();
+
+    run_happy_eyeballs_stalled(ctx, port);
+  }
+
+  // Probed with a raw socket, not the library: a Listener that cannot
+  // open IPv6 must fail the dual-stack round, not skip it.
+  bool ipv6_loopback_available()
+  {
+#if defined(_WIN32)
+    return false;
+#else
+    const int fd = ::socket(AF_INET6, SOCK_STREAM, 0);
+    if (fd < 0)
+      return false;
+
+    sockaddr_in6 addr{};
+    addr.sin6_family = AF_INET6;
+    addr.sin6_addr = in6addr_loopback;
+    addr.sin6_port = 0;
+
+    const bool ok = ::bind(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) == 0;
+    ::close(fd);
+    return ok;
+#endif
+  }
+
+  // Dual-stack: one "::" listener serves an IPv6 and an IPv4 client.
+  void run_dual_stack_server(std::atomic<std::uint16_t> &port)
+  {
+    Context ctx;
+
+    Listener listener(ctx);
+    require_ok("listener.open", listener.open());
+    require_ok("listener.set_v6_only", listener.set_v6_only(false));
+    require_ok("listener.bind", listener.bind(TcpEndpoint{"::", 0}));
+    assert(listener.bind(0).code == ErrorCode::invalid_state);
+    require_ok("listener.listen", listener.listen(2));
+
+    const TcpEndpoint local = listener.local_endpoint();
+    assert(local.address == "::");
+    port.store(local.port, std::memory_order_release);
+
+    for (int i = 0; i < 2; ++i)
+    {
+      auto accepted = listener.accept();
+      if (!accepted.ok())
+        fail("listener.accept", accepted.error);
+
+      Socket &client = accepted.socket;
+
+      char buffer[64]{};
+      auto r = client.read_some(buffer, sizeof(buffer));
+      require_ok("dual_stack_server.read_some", r);
+
+      auto w = client.write_all(buffer, r.bytes);
+      require_ok("dual_stack_server.write_all", w);
+
+      client.close();
+    }
+
+    listener.close();
+  }
+
+  void run_dual_stack_client(std::uint16_t port)
+  {
+    for (const char *address : {"::1", "127.0.0.1"})
+    {
+      Context ctx;
+      ContextPump pump(ctx);
+
+      Socket sock(ctx);
+      require_ok("dual_stack_client.connect", sock.connect(TcpEndpoint{address, port}));
+
+      const TcpEndpoint remote = sock.remote_endpoint();
+      assert(remote.address == address);
+      assert(remote.port == port);
+      assert(sock.local_endpoint().port != 0);
+
+      const std::string msg = "dual stack";
+      require_ok("dual_stack_client.write_all", sock.write_all(msg.data(), msg.size()));
+
+      char buffer[64]{};
+      auto r = sock.read_exact(buffer, msg.size());
+      require_ok("dual_stack_client.read_exact", r);
+      assert(std::string(buffer, r.bytes) == msg);
+
+      sock.close();
+      pump.stop();
+    }
+  }
+
+  // The server binds port 0 and publishes the port the kernel picked.
+  void run_round(void (*server)(std::atomic<std::uint16_t> &),
+                 void (*client)(std::uint16_t))
+  {
+    std::atomic<std::uint16_t> port{0};
+
+    std::thread server_thread([&]
+                              { server(port); });
+
+    for (int i = 0; i < 400; ++i)
+    {
+      if (port.load(std::memory_order_acquire) != 0)
+        break;
+      sleep_short();
+    }
+
+    client(port.load(std::memory_order_acquire));
+
+    server_thread.join();
+  }
+} // namespace
+
+int main()
+{
+  run_round(run_server_once, run_client_once);
+  run_round(run_server_once, run_async_client_once);
+  run_round(run_serve_server, run_serve_clients);
+  run_round(run_silent_server, run_deadline_client);
+  run_round(run_try_server, run_try_client);
+  run_round(run_vectored_server, run_vectored_client);
+  run_round(run_partial_server, run_partial_client);
+  run_round(run_zero_copy_server, run_zero_copy_client);
+  run_round(run_zero_copy_reopen_server, run_zero_copy_reopen_client);
+  run_round(run_send_file_server, run_send_file_client);
+  run_round(run_fast_open_server, run_fast_open_client);
+  run_round(run_happy_eyeballs_server, run_happy_eyeballs_client);
 
-  server_thread.join();
+  if (ipv6_loopback_available())
+    run_round(run_dual_stack_server, run_dual_stack_client);
+  else
+    std::cout << "[test_tcp_echo] IPv6 loopback not available, skipping dual stack\n";
 
   std::cout << "[test_tcp_echo] OK\n";
   return 0;
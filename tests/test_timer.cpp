@@ -0,0 +1,258 @@
+#include <vix/net_corosio/context.hpp>
+#include <vix/net_corosio/error.hpp>
+#include <vix/net_corosio/task.hpp>
+#include <vix/net_corosio/timer.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+using namespace vix::net_corosio;
+using namespace std::chrono_literals;
+
+namespace
+{
+  struct WaitRecord final
+  {
+    Error error{ErrorCode::unknown};
+    Timer::time_point woke{};
+    bool done{false};
+  };
+
+  Task<> wait_and_record(Timer &t, WaitRecord &rec, std::size_t &started)
+  {
+    ++started;
+    rec.error = co_await t.async_wait();
+    rec.woke = Timer::clock::now();
+    rec.done = true;
+  }
+
+  Task<> wait_in_order(Timer &t, std::size_t index, std::vector<std::size_t> &order)
+  {
+    const Error e = co_await t.async_wait();
+    assert(!e);
+    (void)e;
+    order.push_back(index);
+  }
+
+  Task<> cancel_after(Timer &first, Timer &victim)
+  {
+    (void)co_await first.async_wait();
+    (void)victim.cancel();
+  }
+
+  Task<> cancel_now(Timer &victim)
+  {
+    (void)victim.cancel();
+    co_return;
+  }
+
+  // Drive the loop for a short while from the test thread.
+  void pump(Context &ctx)
+  {
+    Timer tick(ctx);
+    tick.expires_after(2ms);
+    const Error e = tick.wait();
+    assert(!e);
+    (void)e;
+  }
+
+  void test_wait_elapses()
+  {
+    Context ctx;
+    Timer t(ctx);
+
+    const auto start = Timer::clock::now();
+    t.expires_after(20ms);
+
+    const Error e = t.wait();
+    const auto elapsed = Timer::clock::now() - start;
+
+    assert(!e);
+    assert(elapsed >= 20ms);
+    (void)e;
+    (void)elapsed;
+
+    // An expiry in the past completes at once.
+    t.expires_at(Timer::clock::now() - 1s);
+    const Error past = t.wait();
+    assert(!past);
+    (void)past;
+
+    std::cout << "[test_timer] test_wait_elapses OK\n";
+  }
+
+  void test_cancel()
+  {
+    Context ctx;
+    Timer t(ctx);
+    t.expires_after(10s);
+
+    WaitRecord rec;
+    std::size_t started = 0;
+    ctx.spawn(wait_and_record(t, rec, started));
+
+    pump(ctx);
+    assert(started == 1);
+    assert(!rec.done);
+
+    const std::size_t n = t.cancel();
+    assert(n == 1);
+    (void)n;
+
+    // Nothing left to cancel.
+    const std::size_t again = t.cancel();
+    assert(again == 0);
+    (void)again;
+
+    pump(ctx);
+    assert(rec.done);
+    assert(rec.error.code == ErrorCode::canceled);
+
+    std::cout << "[test_timer] test_cancel OK\n";
+  }
+
+  // A cancelled timer must not keep run() busy until its old due time.
+  void test_cancel_releases_run()
+  {
+    {
+      Context ctx;
+      Timer t(ctx);
+      t.expires_after(30s);
+
+      WaitRecord rec;
+      std::size_t started = 0;
+      ctx.spawn(wait_and_record(t, rec, started));
+      ctx.spawn(cancel_now(t));
+
+      const auto start = Timer::clock::now();
+      const Error e = ctx.run();
+      const auto elapsed = Timer::clock::now() - start;
+
+      assert(!e);
+      assert(elapsed < 5s);
+      assert(rec.done && rec.error.code == ErrorCode::canceled);
+      (void)e;
+      (void)elapsed;
+    }
+
+    // Cancelled while the backend is already sleeping towards it.
+    {
+      Context ctx;
+      Timer t(ctx);
+      Timer first(ctx);
+      t.expires_after(30s);
+      first.expires_after(20ms);
+
+      WaitRecord rec;
+      std::size_t started = 0;
+      ctx.spawn(wait_and_record(t, rec, started));
+      ctx.spawn(cancel_after(first, t));
+
+      const auto start = Timer::clock::now();
+      const Error e = ctx.run();
+      const auto elapsed = Timer::clock::now() - start;
+
+      assert(!e);
+      assert(elapsed >= 20ms && elapsed < 5s);
+      assert(rec.done && rec.error.code == ErrorCode::canceled);
+      (void)e;
+      (void)elapsed;
+    }
+
+    std::cout << "[test_timer] test_cancel_releases_run OK\n";
+  }
+
+  void test_expiry_order()
+  {
+    Context ctx;
+
+    constexpr std::size_t count = 200;
+
+    std::vector<Timer> timers;
+    timers.reserve(count);
+
+    std::vector<std::size_t> order;
+
+    // Expiries spread over 1..40 ms, inserted out of order.
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      timers.emplace_back(ctx);
+      timers.back().expires_after(std::chrono::milliseconds(1 + (i * 7) % 40));
+      ctx.spawn(wait_in_order(timers.back(), i, order));
+    }
+
+    const Error e = ctx.run();
+    assert(!e);
+    (void)e;
+
+    assert(order.size() == count);
+
+    for (std::size_t i = 1; i < order.size(); ++i)
+    {
+      const auto prev = timers[order[i - 1]].expiry();
+      const auto cur = timers[order[i]].expiry();
+
+      // Same-millisecond expiries may complete in any order.
+      assert(prev <= cur + 1ms);
+      (void)prev;
+      (void)cur;
+    }
+
+    std::cout << "[test_timer] test_expiry_order OK\n";
+  }
+
+  void test_many_armed_timers()
+  {
+    Context ctx;
+
+    constexpr std::size_t count = 100000;
+
+    std::vector<Timer> timers;
+    timers.reserve(count);
+
+    std::vector<WaitRecord> records(count);
+    std::size_t started = 0;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      timers.emplace_back(ctx);
+      timers.back().expires_after(60s + std::chrono::milliseconds(i % 5000));
+      ctx.spawn(wait_and_record(timers.back(), records[i], started));
+    }
+
+    while (started != count)
+      pump(ctx);
+
+    std::size_t cancelled = 0;
+    for (auto &t : timers)
+      cancelled += t.cancel();
+
+    assert(cancelled == count);
+
+    pump(ctx);
+
+    for (const auto &rec : records)
+    {
+      assert(rec.done);
+      assert(rec.error.code == ErrorCode::canceled);
+      (void)rec;
+    }
+
+    std::cout << "[test_timer] test_many_armed_timers OK\n";
+  }
+} // namespace
+
+int main()
+{
+  test_wait_elapses();
+  test_cancel();
+  test_cancel_releases_run();
+  test_expiry_order();
+  test_many_armed_timers();
+
+  std::cout << "[test_timer] all tests passed\n";
+  return 0;
+}